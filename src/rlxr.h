@@ -22,6 +22,40 @@
  *          This is done to prevent the headset view freezing when the game window
  *          is not visible or focused but it might interfere with app logic, in that
  *          case this behavior can be disabled.
+ *
+ *      #define RLXR_DIRECT_ACTION_QUERIES
+ *          By default UpdateXr fetches the state of every action (and locates every
+ *          pose action) once per frame right after syncing and the rlGet* functions
+ *          read from that snapshot. Define this to instead query the runtime on every
+ *          rlGet* call (the snapshot is not allocated nor updated).
+ *
+ *      #define RLXR_JOB_SAFETY_MARGIN 1000000
+ *          Time (in nanoseconds) kept free before the expected return of the next
+ *          xrWaitFrame when dispatching jobs queued with EnqueueXrJob. Increase this
+ *          if jobs cause missed frames on runtimes with a jittery frame pacing.
+ *
+ *      #define RLXR_MAX_INPUT_EVENTS 256
+ *          Capacity of the input event queue drained with rlPollXrInputEvent, when
+ *          the queue is full the oldest events are dropped. The queue is filled
+ *          from the per-frame action snapshot and so it stays empty when
+ *          RLXR_DIRECT_ACTION_QUERIES is defined.
+ *
+ *      #define RLXR_LOCATE_CACHE_SIZE 64
+ *          Number of (space, time) locations cached within a frame (must be a power
+ *          of two), repeated GetXrViewPoseAt / rlGetPoseAt queries and rlGet* pose
+ *          queries with RLXR_DIRECT_ACTION_QUERIES are answered from this cache
+ *          until the next UpdateXr or SetXrReference.
+ *
+ *      #define RLXR_BAKE_REFERENCE_OFFSET
+ *          By default the offset set with SetXrPosition / SetXrOrientation is applied on
+ *          the CPU to every located pose. Define this to instead bake it into the reference
+ *          space (poseInReferenceSpace) so the runtime returns already offset poses. Offset
+ *          changes are applied by recreating the reference space once in the next UpdateXr,
+ *          until then all poses (including the views of the current frame) keep the previous offset.
+ *
+ *      (note: action filters set with rlSetActionFilter are applied to the snapshot and
+ *       are also ignored when RLXR_DIRECT_ACTION_QUERIES is defined, thread safe input
+ *       snapshots (rlAcquireInputSnapshot) are not published either)
  */
 
 #ifndef RLXR_H
@@ -82,10 +116,13 @@
     #define RLXR_ALLOW_EVENT_WAITING
 #endif
 
-#define RLXR_MAX_SPACES_PER_ACTION 2
+#define RLXR_DEVICE_COUNT 19 // number of rlActionDevices bits
+#define RLXR_HAND_JOINT_COUNT 26
 #define RLXR_MAX_PATH_LENGTH 256
 
 #define RLXR_NULL_ACTION (~(unsigned int)0)
+#define RLXR_NULL_ACTION_SET (~(unsigned int)0)
+#define RLXR_PRIMARY_ACTION_SET 0
 
 #ifndef RLXR_APP_NAME
     #define RLXR_APP_NAME "rlxr app"
@@ -95,6 +132,18 @@
     #define RLXR_ENGINE_NAME "raylib / rlxr"
 #endif
 
+#ifndef RLXR_JOB_SAFETY_MARGIN
+    #define RLXR_JOB_SAFETY_MARGIN 1000000 // 1ms
+#endif
+
+#ifndef RLXR_MAX_INPUT_EVENTS
+    #define RLXR_MAX_INPUT_EVENTS 256
+#endif
+
+#ifndef RLXR_LOCATE_CACHE_SIZE
+    #define RLXR_LOCATE_CACHE_SIZE 64
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -136,11 +185,32 @@ typedef enum {
 } rlActionType;
 
 typedef enum {
-    RLXR_HAND_LEFT = 1,
-    RLXR_HAND_RIGHT = 2,
-
-    RLXR_HAND_BOTH = 1 | 2,
-} rlActionDevices;
+    RLXR_HAND_LEFT = 1 << 0,
+    RLXR_HAND_RIGHT = 1 << 1,
+
+    RLXR_HAND_BOTH = RLXR_HAND_LEFT | RLXR_HAND_RIGHT,
+
+    RLXR_DEVICE_HEAD = 1 << 2,
+    RLXR_DEVICE_GAMEPAD = 1 << 3,
+    RLXR_DEVICE_TREADMILL = 1 << 4,
+
+    // tracker roles (XR_HTCX_vive_tracker_interaction)
+    RLXR_TRACKER_HANDHELD_OBJECT = 1 << 5,
+    RLXR_TRACKER_LEFT_FOOT = 1 << 6,
+    RLXR_TRACKER_RIGHT_FOOT = 1 << 7,
+    RLXR_TRACKER_LEFT_SHOULDER = 1 << 8,
+    RLXR_TRACKER_RIGHT_SHOULDER = 1 << 9,
+    RLXR_TRACKER_LEFT_ELBOW = 1 << 10,
+    RLXR_TRACKER_RIGHT_ELBOW = 1 << 11,
+    RLXR_TRACKER_LEFT_KNEE = 1 << 12,
+    RLXR_TRACKER_RIGHT_KNEE = 1 << 13,
+    RLXR_TRACKER_WAIST = 1 << 14,
+    RLXR_TRACKER_CHEST = 1 << 15,
+    RLXR_TRACKER_CAMERA = 1 << 16,
+    RLXR_TRACKER_KEYBOARD = 1 << 17,
+
+    RLXR_DEVICE_EYES = 1 << 18, // (XR_EXT_eye_gaze_interaction)
+} rlActionDevices; // (flags) an action can be used with any combination of devices, but states are always fetched for a single device
 
 typedef enum {
     RLXR_COMPONENT_SELECT = 0,
@@ -151,12 +221,45 @@ typedef enum {
     RLXR_COMPONENT_MAX_ENUM,
 } rlActionComponent;
 
+typedef enum {
+    RLXR_FILTER_NONE = 0,
+    RLXR_FILTER_ONE_EURO, // pose actions, [param0] minimum cutoff frequency in Hz (lower == smoother at rest), [param1] speed coefficient (higher == less lag when moving)
+    RLXR_FILTER_SPRING,   // pose actions, critically damped spring, [param0] smoothing time in seconds
+    RLXR_FILTER_DEADZONE, // float and vector2 actions, [param0] deadzone radius in range [0.0, 1.0), values outside are rescaled to start at 0.0
+} rlActionFilter;
+
 typedef enum {
     RLXR_REFERENCE_LOCAL = 0,
     RLXR_REFERENCE_LOCAL_FLOOR,
     RLXR_REFERENCE_STAGE,
 } rlReferenceType;
 
+typedef enum {
+    RLXR_PERF_DOMAIN_CPU = 0,
+    RLXR_PERF_DOMAIN_GPU,
+} rlPerfDomain;
+
+typedef enum {
+    RLXR_PERF_SUBDOMAIN_COMPOSITING = 0,
+    RLXR_PERF_SUBDOMAIN_RENDERING,
+    RLXR_PERF_SUBDOMAIN_THERMAL,
+} rlPerfSubDomain;
+
+typedef enum {
+    RLXR_PERF_LEVEL_POWER_SAVINGS = 0,
+    RLXR_PERF_LEVEL_SUSTAINED_LOW,
+    RLXR_PERF_LEVEL_SUSTAINED_HIGH,
+    RLXR_PERF_LEVEL_BOOST,
+} rlPerfLevel;
+
+typedef enum {
+    RLXR_PERF_NOTIFICATION_NORMAL = 0,
+    RLXR_PERF_NOTIFICATION_WARNING,
+    RLXR_PERF_NOTIFICATION_IMPAIRED,
+} rlPerfNotification;
+
+typedef void (*rlXrJobFunc)(void *userData);
+
 typedef struct {
     bool value;
     bool active;
@@ -180,6 +283,77 @@ typedef struct {
     bool active;
 } rlPoseState;
 
+typedef struct {
+    Vector3 linear;  // meters per second
+    Vector3 angular; // rotation axis scaled by angular speed (radians per second)
+
+    bool isLinearValid;
+    bool isAngularValid;
+} rlVelocity;
+
+typedef union {
+    bool b;    // RLXR_TYPE_BOOLEAN
+    float f;   // RLXR_TYPE_FLOAT
+    Vector2 v; // RLXR_TYPE_VECTOR2F
+} rlInputValue;
+
+typedef struct {
+    unsigned int action;
+    rlActionDevices device;
+    rlActionType type;
+
+    rlInputValue oldValue;
+    rlInputValue newValue;
+
+    long long time; // XrTime (in nanoseconds) of the change as reported by the runtime
+} rlInputEvent;
+
+typedef struct rlInputSnapshot rlInputSnapshot; // (opaque) a published copy of one frames action snapshot, see rlAcquireInputSnapshot
+
+typedef enum {
+    RLXR_JOINT_PALM = 0,
+    RLXR_JOINT_WRIST,
+    RLXR_JOINT_THUMB_METACARPAL,
+    RLXR_JOINT_THUMB_PROXIMAL,
+    RLXR_JOINT_THUMB_DISTAL,
+    RLXR_JOINT_THUMB_TIP,
+    RLXR_JOINT_INDEX_METACARPAL,
+    RLXR_JOINT_INDEX_PROXIMAL,
+    RLXR_JOINT_INDEX_INTERMEDIATE,
+    RLXR_JOINT_INDEX_DISTAL,
+    RLXR_JOINT_INDEX_TIP,
+    RLXR_JOINT_MIDDLE_METACARPAL,
+    RLXR_JOINT_MIDDLE_PROXIMAL,
+    RLXR_JOINT_MIDDLE_INTERMEDIATE,
+    RLXR_JOINT_MIDDLE_DISTAL,
+    RLXR_JOINT_MIDDLE_TIP,
+    RLXR_JOINT_RING_METACARPAL,
+    RLXR_JOINT_RING_PROXIMAL,
+    RLXR_JOINT_RING_INTERMEDIATE,
+    RLXR_JOINT_RING_DISTAL,
+    RLXR_JOINT_RING_TIP,
+    RLXR_JOINT_LITTLE_METACARPAL,
+    RLXR_JOINT_LITTLE_PROXIMAL,
+    RLXR_JOINT_LITTLE_INTERMEDIATE,
+    RLXR_JOINT_LITTLE_DISTAL,
+    RLXR_JOINT_LITTLE_TIP,
+} rlHandJoint;
+
+// hand joints stored as structure-of-arrays, indexed by rlHandJoint
+typedef struct {
+    bool active;                         // false if the hand is not currently tracked (all arrays are zeroed)
+    unsigned int validJoints;            // bitmask of joints with a valid pose (1 << rlHandJoint)
+    unsigned int validLinearVelocities;  // bitmask of joints with a valid linear velocity (invalid ones are zeroed)
+    unsigned int validAngularVelocities; // bitmask of joints with a valid angular velocity (invalid ones are zeroed)
+
+    float positions[RLXR_HAND_JOINT_COUNT * 3];    // xyz, with the reference offset applied
+    float orientations[RLXR_HAND_JOINT_COUNT * 4]; // xyzw quaternions, with the reference offset applied
+    float radii[RLXR_HAND_JOINT_COUNT];
+
+    float linearVelocities[RLXR_HAND_JOINT_COUNT * 3];  // xyz (meters per second)
+    float angularVelocities[RLXR_HAND_JOINT_COUNT * 3]; // xyz (radians per second)
+} rlHandJoints;
+
 //----------------------------------------------------------------------------------
 // Module Functions Declaration
 //----------------------------------------------------------------------------------
@@ -193,28 +367,96 @@ RLAPI bool IsXrConnected();   // returns true after InitXr(), returns false afte
 RLAPI bool IsXrFocused();     // returns true if the XR device is awake and providing input to the app
 RLAPI rlXrState GetXrState(); // returns the current XR session state
 
+// Frame timing
+RLAPI long long GetXrPredictedDisplayTime();          // returns the XrTime (in nanoseconds) at which the current frame is predicted to be displayed
+RLAPI long long GetXrDisplayPeriod();                 // returns the predicted duration of a frame (in nanoseconds)
+RLAPI long long GetXrCurrentTime();                   // returns the current XrTime (in nanoseconds), 0 if the runtime doesn't support clock conversion
+RLAPI long long ConvertXrTimeToClock(long long time); // converts an XrTime to the system monotonic clock (CLOCK_MONOTONIC / QueryPerformanceCounter, in nanoseconds), 0 if unsupported
+RLAPI long long ConvertClockToXrTime(long long time); // converts a system monotonic clock time (in nanoseconds) to an XrTime, 0 if unsupported
+
+// Display
+RLAPI int GetXrRefreshRates(float *rates, int maxCount); // fills [rates] with up to [maxCount] display refresh rates (in Hz) supported by the runtime, returns the number of rates written (0 if XR_FB_display_refresh_rate is not supported)
+RLAPI bool SetXrRefreshRate(float rate);                 // requests a display refresh rate (in Hz, must be one of GetXrRefreshRates or 0.0 to let the runtime choose), returns true if the request was accepted
+RLAPI float GetXrRefreshRate();                          // returns the current display refresh rate (in Hz), 0.0 if unknown
+
+// Performance
+RLAPI bool SetXrPerfLevel(rlPerfDomain domain, rlPerfLevel level);                                // hints the runtime about the required CPU / GPU performance level, returns false if XR_EXT_performance_settings is not supported
+RLAPI rlPerfNotification GetXrPerfNotification(rlPerfDomain domain, rlPerfSubDomain subDomain); // returns the last performance notification level sent by the runtime for a domain and sub-domain (NORMAL by default)
+
+// Job Scheduling
+RLAPI bool EnqueueXrJob(rlXrJobFunc func, void *userData, long budget); // queues a job to be ran by UpdateXr in the idle time before the next frame, [budget] is the expected job duration in nanoseconds; returns false if the job can never fit in a frame
+RLAPI int GetXrPendingJobCount();                                      // returns the number of queued jobs not yet ran
+
+// Latency Instrumentation
+RLAPI bool StartXrLatencyLog(const char *fileName); // starts writing per-frame pose sampling, frame wait, GPU completion and display timestamps into a CSV file, returns false if the file could not be opened
+RLAPI void StopXrLatencyLog();                      // stops and flushes the latency log
+
+// Recording and Replay
+RLAPI bool StartXrRecording(const char *fileName); // starts writing the frame state, located views, action snapshot and session state events of every frame into a binary file, returns false if the file could not be opened
+RLAPI void StopXrRecording();                      // stops and flushes the recording
+RLAPI bool InitXrReplay(const char *fileName);     // initializes rlxr without a runtime, feeding every UpdateXr from a recording at full speed (call instead of InitXr, the recorded actions must be loaded in the same order); disconnects at the end of the recording
+
 // Spaces and Poses
 RLAPI rlPose GetXrViewPose();                 // returns the pose of the users view (usually the centroid between XR views used in BeginView)
+RLAPI rlPose GetXrViewPoseAt(long long time); // returns the pose of the users view at an arbitrary XrTime (eg. GetXrPredictedDisplayTime() + GetXrDisplayPeriod())
+RLAPI rlVelocity GetXrViewVelocity();         // returns the velocity of the users view at the predicted display time
+RLAPI rlPose ExtrapolateXrPose(rlPose pose, rlVelocity velocity, float dt); // extrapolates [pose] by [dt] seconds with a constant [velocity] (eg. for physics sub-steps), invalid velocity components are ignored
 RLAPI void SetXrPosition(Vector3 pos);        // sets the offset of the reference space, this offsets the entire play space (including the users cameras / views) by [pos] allowing you to move the player though-out the virtual space
-RLAPI void SetXrOrientation(Quaternion quat); // sets the offset rotation of the reference space
+RLAPI void SetXrOrientation(Quaternion quat); // sets the offset rotation of the reference space, the play space (including tracked positions) is rotated around its origin before being offset by the position
 RLAPI rlPose GetXrPose();                     // fetches the current reference frame offsets
 
 RLAPI bool SetXrReference(rlReferenceType type); // requests a different reference space (tracking) type, returns true if supported and successful, false otherwise
 RLAPI rlReferenceType GetXrReference();          // gets the currently active reference space type, by default LOCAL_FLOOR is chosen on init, falling back to LOCAL if LOCAL_FLOOR is not supported
 
+RLAPI bool IsXrRecentered();                        // returns true if the reference space origin changed in this frame (eg. the user recentered) and tracked poses jump, false for compensated recenters
+RLAPI rlPose GetXrRecenterPose();                   // returns the pose of the new reference space origin in the previous one for the last recenter (invalid if unknown to the runtime)
+RLAPI long long GetXrRecenterTime();                // returns the XrTime at which the last recenter took effect, 0 if none
+RLAPI void SetXrRecenterCompensation(bool enabled); // when enabled, recenters are compensated by offsetting the reference space by the inverse change, keeping the virtual world in place (disabled by default)
+
+RLAPI Vector2 GetXrPlayAreaBounds();                // returns the size of the play area rectangle (x: width, y: depth) centered at the STAGE origin, (0, 0) if unavailable
+RLAPI float GetXrPlayAreaDistance(Vector3 position); // returns the horizontal distance from a position (eg. a pose from rlGetPoseState) to the play area edge, negative when outside, FLT_MAX if unavailable
+
+// Hand Tracking
+RLAPI bool IsXrHandTrackingSupported();                             // returns true if the runtime and system support articulated hand tracking (XR_EXT_hand_tracking)
+RLAPI bool GetXrHandJoints(rlActionDevices hand, rlHandJoints *joints); // copies the joints of RLXR_HAND_LEFT or RLXR_HAND_RIGHT located by the last UpdateXr, returns false if the hand is not tracked
+
+// Eye Gaze
+RLAPI bool IsXrEyeGazeSupported(); // returns true if the runtime and system support eye gaze interaction (XR_EXT_eye_gaze_interaction)
+RLAPI rlPoseState GetXrGaze();     // returns the eye gaze pose (looking down its -Z axis) from the current frame action snapshot, inactive if not supported or not tracked
+
 // View Rendering
 RLAPI int BeginXrMode();                  // returns the number of views that are requested by the xr runtime (returns 0 if rendering is not required by the runtime, eg. app is not visible to user)
 RLAPI void EndXrMode();                   // end and submit frame, *must* be called even when 0 views are requested
 RLAPI void BeginView(unsigned int index); // begin view with index in range [0, request_count), this sets up 3D rendering with an internal camera matching the view
 RLAPI void EndView();                     // finish view and disable 3D rendering
 
+// Action Sets
+RLAPI unsigned int rlLoadActionSet(const char *name, int priority); // register a new action set, actions of higher priority sets override lower priority actions bound to the same input; [mustn't be called after first UpdateXr() call]
+RLAPI void rlUseActionSet(unsigned int set);                        // select the action set following rlLoadAction calls create actions in (by default RLXR_PRIMARY_ACTION_SET); [mustn't be called after first UpdateXr() call]
+RLAPI void rlSetActionSetActive(unsigned int set, bool active);     // enables or disables syncing of an action set, actions of inactive sets are reported as inactive (all sets are active by default)
+RLAPI bool rlIsActionSetActive(unsigned int set);
+
 // Action and Bindings
 RLAPI unsigned int rlLoadAction(const char *name, rlActionType type, rlActionDevices devices); // register a new action with the XR runtime; [mustn't be called after first UpdateXr() call]
 RLAPI void rlSuggestBinding(unsigned int action, rlActionComponent component);                 // suggest a binding for an action, this can be ignored / remapped by the XR runtime; [mustn't be called after first UpdateXr() call]
 
-RLAPI void rlSuggestProfile(const char *profilePath);                                                    // select the interaction profile used for following binding suggestions (by default /interaction_profiles/khr/simple_controller), the same profile mustn't be selected twice; [mustn't be called after UpdateXr]
+RLAPI void rlSuggestProfile(const char *profilePath);                                                    // select the interaction profile used for following binding suggestions (by default /interaction_profiles/khr/simple_controller); [mustn't be called after UpdateXr]
 RLAPI void rlSuggestBindingPro(unsigned int action, rlActionDevices devices, const char *componentPath); // suggest a binding with a direct openxr component path; [mustn't be called after UpdateXr]
 
+// Action Manifests
+RLAPI bool rlLoadActionManifest(const char *fileName);         // loads action sets, actions and per-profile bindings from a text manifest (see docs/action_manifest.md), returns false on a parse error; [mustn't be called after first UpdateXr() call]
+RLAPI bool rlLoadActionManifestFromMemory(const char *text);   // same as rlLoadActionManifest, with the manifest already in memory (null-terminated)
+
+// Action Lookup
+RLAPI unsigned int rlGetActionByName(const char *name);   // returns the action loaded with [name] in the current action set (see rlUseActionSet), falling back to the other sets in load order, RLXR_NULL_ACTION if none
+RLAPI unsigned int rlGetActionInSet(unsigned int set, const char *name); // returns the action loaded with [name] in [set], RLXR_NULL_ACTION if none
+RLAPI unsigned int rlGetActionByHash(unsigned int hash);  // returns the action with a name hash from rlGetActionHash (same set order as rlGetActionByName), RLXR_NULL_ACTION if none (allows lookups without touching strings in hot paths)
+RLAPI unsigned int rlGetActionHash(const char *name);     // returns the hash of an action name (32-bit FNV-1a)
+
+// Interaction Profiles
+RLAPI const char *GetXrCurrentProfile(rlActionDevices device); // returns the interaction profile path currently used by a single [device] (eg. "/interaction_profiles/oculus/touch_controller"), NULL if none is bound yet or no action uses the device
+RLAPI bool IsXrProfileChanged();                               // returns true if the interaction profile of any device changed during the last UpdateXr (eg. to (re)load controller models and glyphs)
+
 // Action Fetchers - value only
 RLAPI bool rlGetBool(unsigned int action, rlActionDevices device);
 RLAPI float rlGetFloat(unsigned int action, rlActionDevices device);
@@ -227,9 +469,43 @@ RLAPI rlFloatState rlGetFloatState(unsigned int action, rlActionDevices device);
 RLAPI rlVector2State rlGetVector2State(unsigned int action, rlActionDevices device);
 RLAPI rlPoseState rlGetPoseState(unsigned int action, rlActionDevices device);
 
+// Action Fetchers - poses at an arbitrary XrTime
+RLAPI rlPose rlGetPoseAt(unsigned int action, rlActionDevices device, long long time);
+RLAPI rlPoseState rlGetPoseStateAt(unsigned int action, rlActionDevices device, long long time);
+
+// Action Fetchers - velocities (located together with the poses)
+RLAPI rlVelocity rlGetVelocity(unsigned int action, rlActionDevices device);
+
+// Action Fetchers - batched
+RLAPI void rlLocatePoses(const unsigned int *actions, const rlActionDevices *devices, int count, rlPose *poses); // fetches [count] poses at once (same as calling rlGetPose for each pair), located with a single runtime call when XR_KHR_locate_spaces is supported
+
+// Action Events
+RLAPI bool rlPollXrInputEvent(rlInputEvent *event); // pops the oldest queued input event (value changes of boolean, float and vector2 actions, ordered by time), returns false if the queue is empty
+RLAPI void rlClearXrInputEvents();                  // drops all queued input events
+
+// Action Filters
+RLAPI void rlSetActionFilter(unsigned int action, rlActionFilter filter, float param0, float param1); // filters the snapshot values of an action on all of its devices, applied by UpdateXr in a single pass over all filtered actions (input events and velocities stay unfiltered, ignored with RLXR_DIRECT_ACTION_QUERIES)
+
+// Input Snapshots (thread safe)
+RLAPI const rlInputSnapshot *rlAcquireInputSnapshot();              // returns the latest action snapshot published by UpdateXr without locking, callable from any thread (eg. physics or audio), NULL before the first frame or with RLXR_DIRECT_ACTION_QUERIES
+RLAPI void rlReleaseInputSnapshot(const rlInputSnapshot *snapshot); // releases an acquired snapshot, all snapshots *must* be released before CloseXr
+RLAPI long long rlGetSnapshotTime(const rlInputSnapshot *snapshot); // returns the XrTime the snapshot was sampled at (the predicted display time of its frame)
+RLAPI rlBoolState rlGetSnapshotBoolState(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device);
+RLAPI rlFloatState rlGetSnapshotFloatState(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device);
+RLAPI rlVector2State rlGetSnapshotVector2State(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device);
+RLAPI rlPoseState rlGetSnapshotPoseState(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device);
+RLAPI rlVelocity rlGetSnapshotVelocity(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device);
+RLAPI rlPose rlGetSnapshotViewPose(const rlInputSnapshot *snapshot);
+
 // Action Drivers
 RLAPI void rlApplyHaptic(unsigned int action, rlActionDevices device, long duration, float amplitude); // duration in nanoseconds (-1 == min supported duration by runtime), aplitude in range [0.0, 1.0]
 
+// Action Drivers - haptics engine (effects are merged and sent to the runtime by UpdateXr)
+RLAPI void rlPlayHapticEnvelope(unsigned int action, rlActionDevices device, const float *amplitudes, int count, long interval, long long startTime); // queues an amplitude envelope of [count] points [interval] nanoseconds apart (linearly interpolated, range [0.0, 1.0]) starting at XrTime [startTime] (0 == current frame), overlapping effects are summed (on PCM devices the envelope modulates a carrier)
+RLAPI void rlPlayHapticPcm(unsigned int action, rlActionDevices device, const float *samples, int count, float sampleRate, long long startTime);   // queues a PCM waveform (range [-1.0, 1.0]), streamed with XR_FB_haptic_pcm when supported by the device, played as per-frame amplitude pulses otherwise
+RLAPI void rlStopHaptics(unsigned int action, rlActionDevices device);                                                                            // drops all queued effects and stops any haptic feedback of an action on [device]
+RLAPI bool IsXrHapticPcmSupported();                                                                                                              // returns true if XR_FB_haptic_pcm is supported by the runtime (devices may still not support it)
+
 #if defined(__cplusplus)
 }
 #endif
@@ -277,6 +553,9 @@ RLAPI void rlApplyHaptic(unsigned int action, rlActionDevices device, long durat
 #elif defined(__ANDROID__)
     #define XR_USE_PLATFORM_ANDROID
     #define XR_USE_GRAPHICS_API_OPENGL_ES
+    #define XR_USE_TIMESPEC
+
+    #include <time.h> // defines timespec required by openxr_platform.h
 
     #include <EGL/egl.h>
     #include <jni.h> // defines jobject required by openxr_platform.h
@@ -288,6 +567,9 @@ struct android_app *GetAndroidApp(void);
 #else
     #define XR_USE_PLATFORM_XLIB
     #define XR_USE_GRAPHICS_API_OPENGL
+    #define XR_USE_TIMESPEC
+
+    #include <time.h> // defines timespec required by openxr_platform.h
 
     // workaround for raylib / Xlib name collision (https://github.com/raysan5/raylib/blob/59546eb54ad950eb882627670c759a595d338acf/src/platforms/rcore_desktop_glfw.c#L79)
     #define Font X11Font
@@ -312,6 +594,11 @@ struct android_app *GetAndroidApp(void);
 typedef XrSwapchainImageOpenGLKHR rlxrSwapchainImage;
 #elif defined(XR_USE_GRAPHICS_API_OPENGL_ES)
     #include <GLES3/gl3.h> // required for format enums
+    #include <GLES2/gl2ext.h> // EXT_disjoint_timer_query (latency log)
+
+    #ifndef GL_TIMESTAMP
+        #define GL_TIMESTAMP GL_TIMESTAMP_EXT
+    #endif
 
     #define RLXR_ACTIVE_SWAPCHAIN_IMAGE_TYPE XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_ES_KHR
 typedef XrSwapchainImageOpenGLESKHR rlxrSwapchainImage;
@@ -328,7 +615,21 @@ typedef XrSwapchainImageOpenGLESKHR rlxrSwapchainImage;
 #include <stdlib.h>
 #include <string.h>
 
+#include <float.h>
 #include <math.h>
+#include <time.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+
+    #define RLXR_ATOMIC_LOAD(ptr) _InterlockedOr((volatile long *)(ptr), 0)
+    #define RLXR_ATOMIC_STORE(ptr, value) _InterlockedExchange((volatile long *)(ptr), (value))
+    #define RLXR_ATOMIC_ADD(ptr, value) _InterlockedExchangeAdd((volatile long *)(ptr), (value))
+#else
+    #define RLXR_ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_SEQ_CST)
+    #define RLXR_ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_SEQ_CST)
+    #define RLXR_ATOMIC_ADD(ptr, value) __atomic_fetch_add((ptr), (value), __ATOMIC_SEQ_CST)
+#endif
 
 #if defined(__cplusplus)
 extern "C" {
@@ -356,11 +657,217 @@ typedef struct {
 
 typedef struct {
     XrAction action;
-    XrSpace actionSpaces[RLXR_MAX_SPACES_PER_ACTION]; // used only for pose actions
+    XrSpace *actionSpaces; // [deviceCount], used only for pose actions
 
+    rlActionType type;
     rlActionDevices subpaths;
+
+    unsigned int deviceCount;  // (set bits in subpaths)
+    unsigned int sampleOffset; // index of the first device sample in the snapshot
+
+    unsigned int set;
+
+    char name[XR_MAX_ACTION_NAME_SIZE];
+    unsigned int nameHash;
+
+    rlActionFilter filter;
+    float filterParams[2];
 } rlxrAction;
 
+typedef struct {
+    XrActionSet actionSet;
+    bool active;
+} rlxrActionSet;
+
+#define RLXR_INTERNAL_ACTION_SET (RLXR_NULL_ACTION_SET - 1) // set of internal actions, outside of the public set indices
+
+typedef struct {
+    XrPath profile;
+    XrActionSuggestedBinding binding;
+} rlxrBinding;
+
+typedef struct {
+    XrPath path;
+    unsigned int hash; // (of string)
+    char *string;
+} rlxrInternedPath;
+
+typedef struct {
+    bool active;
+    bool changed; // (since last sync)
+    XrTime lastChangeTime;
+
+    union {
+        bool b;
+        float f;
+        Vector2 v;
+    } value;
+
+    // pose actions only
+    XrSpaceLocationFlags locationFlags;
+    XrPosef pose;
+
+    XrSpaceVelocityFlags velocityFlags;
+    XrVector3f linearVelocity;
+    XrVector3f angularVelocity;
+} rlxrActionSample;
+
+typedef struct {
+    XrSpace space;
+    XrTime time;
+    unsigned int generation; // (entries of older generations are stale)
+
+    bool hasVelocity;
+    XrSpaceLocation location;
+    XrSpaceVelocity velocity;
+} rlxrLocateCacheEntry;
+
+#define RLXR_SNAPSHOT_BUFFERS 3
+
+struct rlInputSnapshot {
+    long refs; // (atomic) readers holding this snapshot, only snapshots without readers are rewritten
+
+    XrTime time;
+    Vector3 refPosition; // reference offset at publish time, the getters mustn't read the live one
+    Quaternion refOrientation;
+
+    XrSpaceLocation viewLocation;
+
+    unsigned int sampleCount;
+    rlxrActionSample *samples;
+};
+
+#define RLXR_FILTER_CHANNELS 7 // (position xyz, orientation xyzw)
+
+typedef struct {
+    unsigned int sampleCount;
+    unsigned int *samples; // snapshot index of every filtered pose sample, One-Euro samples first
+    bool *primed;          // (false until the first valid sample, reset when tracking is lost)
+
+    // per channel state, [sample * RLXR_FILTER_CHANNELS + channel]
+    unsigned int channelCount;
+    unsigned int oneEuroChannels; // channels [0, oneEuroChannels) use the One-Euro filter, the rest the spring filter
+    float *raw;
+    float *value;
+    float *deriv; // filtered derivative (One-Euro) or velocity (spring)
+    float *param0;
+    float *param1;
+
+    XrTime lastTime;
+    bool dirty; // (rebuilt on the next pass)
+} rlxrFilterBank;
+
+typedef struct {
+    unsigned int action;
+    int slot;
+
+    XrTime start;
+    double interval; // nanoseconds between samples
+    unsigned int count;
+    float *samples;
+
+    bool pcm; // PCM waveform, amplitude envelope otherwise
+} rlxrHapticEffect;
+
+#define RLXR_HAPTIC_CARRIER_FREQUENCY 160.0 // (Hz) carrier modulated by amplitude envelopes on PCM devices, near the resonance of common actuators
+
+typedef struct {
+    unsigned int action;
+    int slot;
+
+    float sampleRate;   // device PCM sample rate, 0.0 if PCM is not supported by the device
+    XrTime queuedUntil; // end of PCM samples already streamed to the runtime
+} rlxrHapticTarget;
+
+typedef struct {
+    rlXrJobFunc func;
+    void *userData;
+    long budget;
+} rlxrJob;
+
+#define RLXR_LATENCY_FRAMES 4 // frames in flight before the latency log waits for a GPU timestamp
+
+typedef struct {
+    int64_t wakeTime;
+    int64_t locateTime;
+    XrTime displayTime;
+    XrTime displayPeriod;
+
+    GLuint query;        // GL_TIMESTAMP query issued after the last EndView
+    bool queryIssued;
+    int64_t clockOffset; // monotonic clock - GL timestamp, sampled when the query was issued
+} rlxrLatencyFrame;
+
+typedef struct {
+    FILE *file;
+    unsigned int frameIndex; // next frame to be ended
+    unsigned int flushIndex; // next frame to be written
+
+    int64_t locateTime; // monotonic time of the last xrLocateViews call
+    rlxrLatencyFrame frames[RLXR_LATENCY_FRAMES];
+
+    PFNGLGENQUERIESPROC GenQueries;
+    PFNGLDELETEQUERIESPROC DeleteQueries;
+    PFNGLGETQUERYOBJECTUIVPROC GetQueryObjectuiv;
+    PFNGLGETINTEGER64VPROC GetInteger64v;
+#if defined(XR_USE_GRAPHICS_API_OPENGL_ES)
+    PFNGLQUERYCOUNTEREXTPROC QueryCounter;
+    PFNGLGETQUERYOBJECTUI64VEXTPROC GetQueryObjectui64v;
+#else
+    PFNGLQUERYCOUNTERPROC QueryCounter;
+    PFNGLGETQUERYOBJECTUI64VPROC GetQueryObjectui64v;
+#endif
+} rlxrLatencyLog;
+
+// binary recording chunk tags (little endian fourcc)
+#define RLXR_RECORDING_MAGIC 0x52584c52 // "RLXR"
+#define RLXR_RECORDING_VERSION 1
+#define RLXR_CHUNK_EVENT 0x544e5645   // "EVNT", rlxrEventRecord
+#define RLXR_CHUNK_FRAME 0x4d415246   // "FRAM", rlxrFrameRecord
+#define RLXR_CHUNK_ACTIONS 0x53544341 // "ACTS", rlxrActionSample[sampleCount]
+#define RLXR_CHUNK_VIEWS 0x57454956   // "VIEW", rlxrViewRecord[viewCount]
+
+#define RLXR_RECORDING_EYE_GAZE (1 << 0)
+#define RLXR_RECORDING_VIVE_TRACKER (1 << 1)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sampleSize; // sizeof(rlxrActionSample), recordings are only replayable by a matching build
+    uint32_t viewCount;
+    uint32_t flags; // RLXR_RECORDING_* (extensions that change the action layout)
+} rlxrRecordingHeader;
+
+typedef struct {
+    int32_t state; // XrSessionState
+    XrTime time;
+} rlxrEventRecord;
+
+typedef struct {
+    XrTime predictedDisplayTime;
+    XrDuration predictedDisplayPeriod;
+    uint32_t shouldRender;
+
+    XrSpaceLocationFlags viewLocationFlags;
+    XrPosef viewPose;
+    XrSpaceVelocityFlags viewVelocityFlags;
+    XrVector3f viewLinearVelocity;
+    XrVector3f viewAngularVelocity;
+} rlxrFrameRecord;
+
+typedef struct {
+    XrPosef pose;
+    XrFovf fov;
+} rlxrViewRecord;
+
+typedef struct {
+    FILE *file;
+    unsigned int frameCount;
+
+    void *buffer; // (replay only) last read chunk
+    unsigned int bufferSize;
+} rlxrRecording;
+
 typedef struct {
     // session state //
 
@@ -384,37 +891,151 @@ typedef struct {
 
     bool depthSupported;
 
+    // display //
+
+    float refreshRate;
+    unsigned int refreshRateCount;
+    float *refreshRates;
+
+    // performance //
+
+    rlPerfNotification perfNotifications[2][3]; // [domain][subDomain]
+
     // spaces //
 
     XrSpace referenceSpace;
     rlReferenceType referenceType;
+    XrPosef referencePose; // poseInReferenceSpace of referenceSpace (compensated recenters, plus the baked offset with RLXR_BAKE_REFERENCE_OFFSET)
+
+    bool recenterPending;   // a reference space change event was received, but its changeTime isn't reached yet
+    bool recentered;        // (during the last UpdateXr, not compensated)
+    bool recenterCompensation;
+    bool recenterPoseValid;
+    XrTime recenterTime;
+    XrPosef recenterPose; // new origin in the previous space
 
     Vector3 refPosition;
     Quaternion refOrientation;
 
+    Vector3 offsetPosition; // applied to located poses on the CPU (identity with RLXR_BAKE_REFERENCE_OFFSET)
+    Quaternion offsetOrientation;
+
+    XrPosef bakedOffset;   // offset currently baked into referenceSpace (RLXR_BAKE_REFERENCE_OFFSET)
+    bool bakedOffsetDirty; // (refPosition / refOrientation changed, baked by the next UpdateXr)
+
     XrSpace viewSpace;
 
+    XrSpace stageSpace;                   // (created on the first play area query)
+    bool playAreaValid;                   // (cleared when the STAGE space changes)
+    unsigned int playAreaQueryGeneration; // locateGeneration + 1 of the last failed query (retried once per frame)
+    XrExtent2Df playArea;
+
+    // hand tracking //
+
+    XrHandTrackerEXT handTrackers[2];
+    rlHandJoints handJoints[2]; // located at the predicted display time of the current frame
+
+    // path interning //
+
+    unsigned int pathCount, pathCap;
+    rlxrInternedPath *paths;
+
+    unsigned int pathTableCap;     // power of two
+    unsigned int *pathStringTable; // open-addressing tables, store path index + 1 (0 == empty slot)
+    unsigned int *pathValueTable;
+
     // actions //
 
-    XrActionSet actionSet;
-    XrPath userPaths[2];
+    unsigned int actionSetCount, actionSetCap;
+    rlxrActionSet *actionSets;
+    unsigned int currentActionSet; // set used by rlLoadAction
+
+    unsigned int gazeAction;       // internal eye gaze pose action (RLXR_NULL_ACTION if unsupported)
+    XrActionSet internalActionSet; // always active, not in actionSets (XR_NULL_HANDLE if no internal actions)
+
+    unsigned int activeSetCount, activeSetCap;
+    XrActiveActionSet *activeSets; // sets passed to xrSyncActions, rebuilt when activation changes
+
+    XrPath userPaths[RLXR_DEVICE_COUNT]; // [device slot]
+
+    XrPath currentProfiles[RLXR_DEVICE_COUNT]; // [device slot], refreshed on XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED
+    bool profileChanged;                       // (during the last UpdateXr)
 
     unsigned int actionCount, actionCap;
     rlxrAction *actions;
 
+    unsigned int actionTableCap; // power of two
+    unsigned int *actionTable;   // open-addressing (set, name hash) table, stores action index + 1 (0 == empty slot)
+    unsigned int sampleCount;
+    rlxrActionSample *actionSamples; // per-frame snapshot, [action sampleOffset + device index]
+    rlInputValue *rawValues;         // unfiltered values of the snapshot (action filters modify it in place), input events are built from these
+
+    rlInputEvent inputEvents[RLXR_MAX_INPUT_EVENTS]; // ring buffer of value changes found in the snapshot
+    unsigned int inputEventHead, inputEventCount;
+    unsigned int inputEventsDropped; // (in the current overflow, reported once the queue has room again)
+
+    XrSpaceLocation viewLocation; // view space location in the snapshot
+    XrSpaceVelocity viewVelocity;
+    XrTime viewLocationTime;
+
+    // batched locate scratch buffers //
+
+    unsigned int locateCount, locateCap;
+    XrSpace *locateSpaces;
+    XrSpaceLocation *locateResults;
+    XrSpaceVelocity *locateVelocities;
+    rlxrActionSample **locateTargets;
+#ifdef XR_KHR_locate_spaces
+    XrSpaceLocationDataKHR *locateData; // (XR_KHR_locate_spaces output, converted into locateResults / locateVelocities)
+    XrSpaceVelocityDataKHR *locateVelocityData;
+#endif
+
+    rlxrLocateCacheEntry locateCache[RLXR_LOCATE_CACHE_SIZE];
+    unsigned int locateGeneration; // bumped by UpdateXr and SetXrReference
+
     unsigned int bindingCount, bindingCap;
-    XrActionSuggestedBinding *bindings;
+    rlxrBinding *bindings; // buffered until the first UpdateXr, submitted grouped by profile
     XrPath currentSuggestProfile;
 
     bool actionSetAttached;
 
+    rlxrFilterBank filters;
+
+    rlInputSnapshot snapshots[RLXR_SNAPSHOT_BUFFERS];
+    long latestSnapshot; // (atomic) index of the last published snapshot + 1 (0 == none yet)
+
+    // haptics //
+
+    unsigned int hapticEffectCount, hapticEffectCap;
+    rlxrHapticEffect *hapticEffects;
+
+    unsigned int hapticTargetCount, hapticTargetCap;
+    rlxrHapticTarget *hapticTargets;
+
+    float hapticBuffer[XR_MAX_HAPTIC_PCM_BUFFER_SIZE_FB];
+
     // frame state //
 
     XrFrameState frameState;
+    int64_t frameWakeTime; // monotonic time of the last xrWaitFrame return
 
     bool frameActive;
     unsigned int viewActiveIndex;
 
+    // job scheduling //
+
+    unsigned int jobCount, jobCap;
+    rlxrJob *jobs;
+
+    // instrumentation //
+
+    rlxrLatencyLog latency;
+
+    // recording and replay //
+
+    rlxrRecording recording;
+    rlxrRecording replay; // replay.file is set when running without a runtime (InitXrReplay)
+
     // extended functions //
 
     struct {
@@ -423,10 +1044,42 @@ typedef struct {
 #elif defined(XR_USE_GRAPHICS_API_OPENGL_ES)
         PFN_xrGetOpenGLESGraphicsRequirementsKHR GetOpenGLESGraphicsRequirementsKHR;
 #endif
+
+        PFN_xrEnumerateDisplayRefreshRatesFB EnumerateDisplayRefreshRatesFB;
+        PFN_xrGetDisplayRefreshRateFB GetDisplayRefreshRateFB;
+        PFN_xrRequestDisplayRefreshRateFB RequestDisplayRefreshRateFB;
+
+        PFN_xrPerfSettingsSetPerformanceLevelEXT PerfSettingsSetPerformanceLevelEXT;
+
+        PFN_xrGetDeviceSampleRateFB GetDeviceSampleRateFB;
+
+        PFN_xrCreateHandTrackerEXT CreateHandTrackerEXT;
+        PFN_xrDestroyHandTrackerEXT DestroyHandTrackerEXT;
+        PFN_xrLocateHandJointsEXT LocateHandJointsEXT;
+
+#ifdef XR_KHR_locate_spaces
+        PFN_xrLocateSpacesKHR LocateSpacesKHR;
+#endif
+
+#if defined(XR_USE_PLATFORM_WIN32)
+        PFN_xrConvertWin32PerformanceCounterToTimeKHR ConvertWin32PerformanceCounterToTimeKHR;
+        PFN_xrConvertTimeToWin32PerformanceCounterKHR ConvertTimeToWin32PerformanceCounterKHR;
+#elif defined(XR_USE_TIMESPEC)
+        PFN_xrConvertTimespecTimeToTimeKHR ConvertTimespecTimeToTimeKHR;
+        PFN_xrConvertTimeToTimespecTimeKHR ConvertTimeToTimespecTimeKHR;
+#endif
     } pfn;
 
     struct {
         bool localFloor;
+        bool displayRefreshRate;
+        bool perfSettings;
+        bool convertTime;
+        bool locateSpaces;
+        bool viveTracker;
+        bool handTracking;
+        bool eyeGaze;
+        bool hapticPcm;
 
         bool glEnable;
         bool glesEnable;
@@ -479,81 +1132,423 @@ static bool rlxrFormatInitResult(XrResult res, XrInstanceCreateInfo *info) {
     }
 }
 
-static const char *rlxrFormatResult(XrResult res) {
-    static char buf[XR_MAX_RESULT_STRING_SIZE];
+static int64_t rlxrGetMonotonicTime() {
+    // returns a monotonic timestamp in nanoseconds (QueryPerformanceCounter / CLOCK_MONOTONIC)
 
-    if (rlxr.instance != XR_NULL_HANDLE)
-    {
-        XrResult convRes = xrResultToString(rlxr.instance, res, buf);
-        if (XR_SUCCEEDED(convRes)) return buf;
-    }
+#if defined(_WIN32)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
 
-    snprintf(buf, XR_MAX_RESULT_STRING_SIZE, "%d", res);
-    return buf;
+    return (int64_t)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
 }
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition - OpenXR state management
-//----------------------------------------------------------------------------------
+static void rlxrResizeArray(void **ptr, unsigned int *size, unsigned int *cap, unsigned int new_size, unsigned int elem_size) {
+    *size = new_size;
+    if (new_size <= *cap) return;
 
-static bool rlxrInitLoader() {
-    // platform-specific loader initializers
+    unsigned int new_cap = *cap * 2;
+    *cap = new_cap > new_size ? new_cap : new_size;
 
-    static bool loaderInitialized = false;
-    if (loaderInitialized)
-        return true;
+    *ptr = RL_REALLOC(*ptr, *cap * elem_size);
+}
 
-#ifdef XR_USE_PLATFORM_ANDROID
-    {
-        // attach to the JNI and JVM which is required by the OpenXR Loader
-        struct android_app *android = GetAndroidApp();
+static XrTime rlxrClockToXrTime(int64_t clock) {
+    // converts a rlxrGetMonotonicTime timestamp to XrTime, returns 0 if not supported
 
-        PFN_xrInitializeLoaderKHR pfnXrInitializeLoaderKHR = NULL;
-        XrResult res = xrGetInstanceProcAddr(XR_NULL_HANDLE, "xrInitializeLoaderKHR", (PFN_xrVoidFunction *)&pfnXrInitializeLoaderKHR);
+    if (!rlxr.ext.convertTime) return 0;
 
-        if (XR_FAILED(res) || !pfnXrInitializeLoaderKHR)
-        {
-            TRACELOG(LOG_ERROR, "XR: Failed to get loader entrypoint. (%d)", res);
-            return false;
-        }
+    XrTime time = 0;
+    XrResult res;
 
-        XrLoaderInitInfoAndroidKHR loaderInfo = {XR_TYPE_LOADER_INIT_INFO_ANDROID_KHR};
-        loaderInfo.applicationVM = android->activity->vm;
-        loaderInfo.applicationContext = android->activity->clazz;
+#if defined(XR_USE_PLATFORM_WIN32)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceFrequency(&frequency);
+    counter.QuadPart = (LONGLONG)((double)clock * (double)frequency.QuadPart / 1000000000.0);
 
-        res = pfnXrInitializeLoaderKHR((XrLoaderInitInfoBaseHeaderKHR *)&loaderInfo);
-        if (XR_FAILED(res))
-        {
-            TRACELOG(LOG_ERROR, "XR: Failed to init loader. (%d)", res);
-            return false;
-        }
-    }
+    res = rlxr.pfn.ConvertWin32PerformanceCounterToTimeKHR(rlxr.instance, &counter, &time);
+#elif defined(XR_USE_TIMESPEC)
+    struct timespec ts;
+    ts.tv_sec = clock / 1000000000;
+    ts.tv_nsec = clock % 1000000000;
+
+    res = rlxr.pfn.ConvertTimespecTimeToTimeKHR(rlxr.instance, &ts, &time);
 #endif
 
-    loaderInitialized = true;
-    return true;
+    return XR_SUCCEEDED(res) ? time : 0;
 }
 
-static inline bool rlxrIsExtAvailable(const char *name, XrExtensionProperties *exts, uint32_t extCount) {
-    for (int i = 0; i < extCount; i++)
-    {
-        if (strcmp(name, exts[i].extensionName) == 0) return true;
-    }
+static int64_t rlxrXrTimeToClock(XrTime time) {
+    // converts an XrTime to a rlxrGetMonotonicTime timestamp, returns 0 if not supported
 
-    return false;
+    if (!rlxr.ext.convertTime) return 0;
+
+#if defined(XR_USE_PLATFORM_WIN32)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    XrResult res = rlxr.pfn.ConvertTimeToWin32PerformanceCounterKHR(rlxr.instance, time, &counter);
+    if (XR_FAILED(res)) return 0;
+
+    return (int64_t)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+#elif defined(XR_USE_TIMESPEC)
+    struct timespec ts;
+
+    XrResult res = rlxr.pfn.ConvertTimeToTimespecTimeKHR(rlxr.instance, time, &ts);
+    if (XR_FAILED(res)) return 0;
+
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
 }
 
-static bool rlxrEnumerateExtensions(XrInstanceCreateInfo *info) {
-    // fetch all available extensions
+static XrPosef rlxrComposePose(XrPosef a, XrPosef b) {
+    // returns a * b (b transformed by a)
 
-    XrExtensionProperties *available;
-    uint32_t availableCount;
+    Quaternion qa = {a.orientation.x, a.orientation.y, a.orientation.z, a.orientation.w};
+    Quaternion q = QuaternionMultiply(qa, (Quaternion){b.orientation.x, b.orientation.y, b.orientation.z, b.orientation.w});
+    Vector3 p = Vector3Add((Vector3){a.position.x, a.position.y, a.position.z}, Vector3RotateByQuaternion((Vector3){b.position.x, b.position.y, b.position.z}, qa));
 
-    XrResult res = xrEnumerateInstanceExtensionProperties(NULL, 0, &availableCount, NULL);
-    if (XR_FAILED(res))
+    return (XrPosef){{q.x, q.y, q.z, q.w}, {p.x, p.y, p.z}};
+}
+
+static XrPosef rlxrInvertPose(XrPosef pose) {
+    Quaternion q = QuaternionInvert((Quaternion){pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w});
+    Vector3 p = Vector3Negate(Vector3RotateByQuaternion((Vector3){pose.position.x, pose.position.y, pose.position.z}, q));
+
+    return (XrPosef){{q.x, q.y, q.z, q.w}, {p.x, p.y, p.z}};
+}
+
+static const char *rlxrFormatResult(XrResult res) {
+    static char buf[XR_MAX_RESULT_STRING_SIZE];
+
+    if (rlxr.instance != XR_NULL_HANDLE)
     {
-        if (!rlxrFormatInitResult(res, info)) TRACELOG(LOG_ERROR, "XR: Failed to get available extensions from runtime (%d)", res);
-        return false;
+        XrResult convRes = xrResultToString(rlxr.instance, res, buf);
+        if (XR_SUCCEEDED(convRes)) return buf;
+    }
+
+    snprintf(buf, XR_MAX_RESULT_STRING_SIZE, "%d", res);
+    return buf;
+}
+
+static unsigned int rlxrCreateActionSet(const char *name, const char *localizedName, int priority) {
+    // creates and registers a new action set, returns its index or RLXR_NULL_ACTION_SET
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstringop-truncation"
+
+    XrActionSetCreateInfo setInfo = {XR_TYPE_ACTION_SET_CREATE_INFO};
+    strncpy(setInfo.actionSetName, name, XR_MAX_ACTION_SET_NAME_SIZE);
+    strncpy(setInfo.localizedActionSetName, localizedName, XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE);
+    setInfo.priority = priority;
+
+#pragma GCC diagnostic pop
+
+    // note: replays have no runtime, only the set bookkeeping is kept
+    XrActionSet xrSet = XR_NULL_HANDLE;
+    XrResult res = rlxr.replay.file ? XR_SUCCESS : xrCreateActionSet(rlxr.instance, &setInfo, &xrSet);
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to create action set %s (%s)", name, rlxrFormatResult(res));
+        return RLXR_NULL_ACTION_SET;
+    }
+
+    unsigned int setIdx = rlxr.actionSetCount;
+    rlxrResizeArray((void **)&rlxr.actionSets, &rlxr.actionSetCount, &rlxr.actionSetCap, rlxr.actionSetCount + 1, sizeof(rlxrActionSet));
+
+    rlxr.actionSets[setIdx].actionSet = xrSet;
+    rlxr.actionSets[setIdx].active = true;
+
+    return setIdx;
+}
+
+static void rlxrRebuildActiveSets() {
+    // collects all active action sets for xrSyncActions
+
+    rlxr.activeSetCount = 0;
+
+    for (unsigned int i = 0; i < rlxr.actionSetCount; i++)
+    {
+        if (!rlxr.actionSets[i].active) continue;
+
+        unsigned int activeIdx = rlxr.activeSetCount;
+        rlxrResizeArray((void **)&rlxr.activeSets, &rlxr.activeSetCount, &rlxr.activeSetCap, rlxr.activeSetCount + 1, sizeof(XrActiveActionSet));
+
+        rlxr.activeSets[activeIdx].actionSet = rlxr.actionSets[i].actionSet;
+        rlxr.activeSets[activeIdx].subactionPath = XR_NULL_PATH;
+    }
+
+    if (rlxr.internalActionSet != XR_NULL_HANDLE)
+    {
+        unsigned int activeIdx = rlxr.activeSetCount;
+        rlxrResizeArray((void **)&rlxr.activeSets, &rlxr.activeSetCount, &rlxr.activeSetCap, rlxr.activeSetCount + 1, sizeof(XrActiveActionSet));
+
+        rlxr.activeSets[activeIdx].actionSet = rlxr.internalActionSet;
+        rlxr.activeSets[activeIdx].subactionPath = XR_NULL_PATH;
+    }
+}
+
+static unsigned int rlxrHashString(const char *str) {
+    // 32-bit FNV-1a
+
+    unsigned int hash = 2166136261u;
+
+    for (const char *c = str; *c; c++)
+    {
+        hash ^= (unsigned char)*c;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static inline unsigned int rlxrHashPath(XrPath path) {
+    return (unsigned int)(path ^ (path >> 32)) * 2654435761u;
+}
+
+static void rlxrInsertPathSlots(unsigned int index) {
+    unsigned int mask = rlxr.pathTableCap - 1;
+
+    unsigned int slot = rlxr.paths[index].hash & mask;
+    while (rlxr.pathStringTable[slot] != 0) slot = (slot + 1) & mask;
+    rlxr.pathStringTable[slot] = index + 1;
+
+    slot = rlxrHashPath(rlxr.paths[index].path) & mask;
+    while (rlxr.pathValueTable[slot] != 0) slot = (slot + 1) & mask;
+    rlxr.pathValueTable[slot] = index + 1;
+}
+
+static const char *rlxrAddInternedPath(XrPath path, const char *str, unsigned int hash) {
+    unsigned int index = rlxr.pathCount;
+    rlxrResizeArray((void **)&rlxr.paths, &rlxr.pathCount, &rlxr.pathCap, rlxr.pathCount + 1, sizeof(rlxrInternedPath));
+
+    size_t len = strlen(str);
+
+    rlxrInternedPath *entry = &rlxr.paths[index];
+    entry->path = path;
+    entry->hash = hash;
+    entry->string = (char *)RL_MALLOC(len + 1);
+    memcpy(entry->string, str, len + 1);
+
+    // grow tables to keep their load under 1/2
+
+    if (rlxr.pathCount * 2 > rlxr.pathTableCap)
+    {
+        RL_FREE(rlxr.pathStringTable);
+        RL_FREE(rlxr.pathValueTable);
+
+        rlxr.pathTableCap = rlxr.pathTableCap ? rlxr.pathTableCap * 2 : 64;
+        rlxr.pathStringTable = (unsigned int *)RL_CALLOC(rlxr.pathTableCap, sizeof(unsigned int));
+        rlxr.pathValueTable = (unsigned int *)RL_CALLOC(rlxr.pathTableCap, sizeof(unsigned int));
+
+        for (unsigned int i = 0; i < rlxr.pathCount; i++) rlxrInsertPathSlots(i);
+    } else
+    {
+        rlxrInsertPathSlots(index);
+    }
+
+    return entry->string;
+}
+
+static XrPath rlxrInternPath(const char *str) {
+    // converts a path string to an XrPath, calling the runtime only on the first use of the string
+
+    unsigned int hash = rlxrHashString(str);
+
+    if (rlxr.pathTableCap != 0)
+    {
+        unsigned int mask = rlxr.pathTableCap - 1;
+
+        for (unsigned int slot = hash & mask; rlxr.pathStringTable[slot] != 0; slot = (slot + 1) & mask)
+        {
+            rlxrInternedPath *entry = &rlxr.paths[rlxr.pathStringTable[slot] - 1];
+            if (entry->hash == hash && strcmp(entry->string, str) == 0) return entry->path;
+        }
+    }
+
+    XrPath path;
+    XrResult res = xrStringToPath(rlxr.instance, str, &path);
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to convert path %s (%s)", str, rlxrFormatResult(res));
+        return XR_NULL_PATH;
+    }
+
+    rlxrAddInternedPath(path, str, hash);
+    return path;
+}
+
+static const char *rlxrPathString(XrPath path) {
+    // converts an XrPath back to its string, calling the runtime only for paths not yet interned
+
+    if (path == XR_NULL_PATH) return "(null)";
+
+    if (rlxr.pathTableCap != 0)
+    {
+        unsigned int mask = rlxr.pathTableCap - 1;
+
+        for (unsigned int slot = rlxrHashPath(path) & mask; rlxr.pathValueTable[slot] != 0; slot = (slot + 1) & mask)
+        {
+            rlxrInternedPath *entry = &rlxr.paths[rlxr.pathValueTable[slot] - 1];
+            if (entry->path == path) return entry->string;
+        }
+    }
+
+    char buf[XR_MAX_PATH_LENGTH];
+    uint32_t len;
+
+    XrResult res = xrPathToString(rlxr.instance, path, XR_MAX_PATH_LENGTH, &len, buf);
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to convert path to string (%s)", rlxrFormatResult(res));
+        return "(invalid)";
+    }
+
+    return rlxrAddInternedPath(path, buf, rlxrHashString(buf));
+}
+
+static XrPath rlxrInternSubPath(XrPath parent, const char *component) {
+    // interns [parent] + [component], eg. /user/hand/left + /input/select/click
+
+    char buf[XR_MAX_PATH_LENGTH];
+    snprintf(buf, XR_MAX_PATH_LENGTH, "%s%s", rlxrPathString(parent), component);
+
+    return rlxrInternPath(buf);
+}
+
+// LUT of user paths for all rlActionDevices bits, [device slot]
+static const char *rlxrDevicePaths[RLXR_DEVICE_COUNT] = {
+    "/user/hand/left",
+    "/user/hand/right",
+    "/user/head",
+    "/user/gamepad",
+    "/user/treadmill",
+    "/user/vive_tracker_htcx/role/handheld_object",
+    "/user/vive_tracker_htcx/role/left_foot",
+    "/user/vive_tracker_htcx/role/right_foot",
+    "/user/vive_tracker_htcx/role/left_shoulder",
+    "/user/vive_tracker_htcx/role/right_shoulder",
+    "/user/vive_tracker_htcx/role/left_elbow",
+    "/user/vive_tracker_htcx/role/right_elbow",
+    "/user/vive_tracker_htcx/role/left_knee",
+    "/user/vive_tracker_htcx/role/right_knee",
+    "/user/vive_tracker_htcx/role/waist",
+    "/user/vive_tracker_htcx/role/chest",
+    "/user/vive_tracker_htcx/role/camera",
+    "/user/vive_tracker_htcx/role/keyboard",
+    "/user/eyes_ext",
+};
+
+#define RLXR_TRACKER_DEVICES (RLXR_TRACKER_HANDHELD_OBJECT | RLXR_TRACKER_LEFT_FOOT | RLXR_TRACKER_RIGHT_FOOT | RLXR_TRACKER_LEFT_SHOULDER | RLXR_TRACKER_RIGHT_SHOULDER | RLXR_TRACKER_LEFT_ELBOW | RLXR_TRACKER_RIGHT_ELBOW | \
+                              RLXR_TRACKER_LEFT_KNEE | RLXR_TRACKER_RIGHT_KNEE | RLXR_TRACKER_WAIST | RLXR_TRACKER_CHEST | RLXR_TRACKER_CAMERA | RLXR_TRACKER_KEYBOARD)
+
+static int rlxrDeviceSlot(rlActionDevices device) {
+    // returns the slot (bit index) of a single device, -1 if [device] is not exactly one valid device
+
+    if (device == 0 || (device & (device - 1)) != 0 || device >= (1 << RLXR_DEVICE_COUNT)) return -1;
+
+    int slot = 0;
+    while (!(device & (1 << slot))) slot++;
+
+    return slot;
+}
+
+static int rlxrActionDeviceIndex(const rlxrAction *ac, int slot) {
+    // returns the index of a device slot into the compact per-action arrays, -1 if the action doesn't use the device
+
+    if (slot < 0 || !(ac->subpaths & (1 << slot))) return -1;
+
+    unsigned int lower = ac->subpaths & ((1u << slot) - 1);
+
+    int index = 0;
+    for (; lower; index++) lower &= lower - 1;
+
+    return index;
+}
+
+static void rlxrFreeInternedPaths() {
+    // paths are only valid for the instance they were created with
+
+    for (unsigned int i = 0; i < rlxr.pathCount; i++) RL_FREE(rlxr.paths[i].string);
+
+    RL_FREE(rlxr.paths);
+    RL_FREE(rlxr.pathStringTable);
+    RL_FREE(rlxr.pathValueTable);
+
+    rlxr.paths = NULL;
+    rlxr.pathStringTable = NULL;
+    rlxr.pathValueTable = NULL;
+    rlxr.pathCount = rlxr.pathCap = rlxr.pathTableCap = 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - OpenXR state management
+//----------------------------------------------------------------------------------
+
+static bool rlxrInitLoader() {
+    // platform-specific loader initializers
+
+    static bool loaderInitialized = false;
+    if (loaderInitialized)
+        return true;
+
+#ifdef XR_USE_PLATFORM_ANDROID
+    {
+        // attach to the JNI and JVM which is required by the OpenXR Loader
+        struct android_app *android = GetAndroidApp();
+
+        PFN_xrInitializeLoaderKHR pfnXrInitializeLoaderKHR = NULL;
+        XrResult res = xrGetInstanceProcAddr(XR_NULL_HANDLE, "xrInitializeLoaderKHR", (PFN_xrVoidFunction *)&pfnXrInitializeLoaderKHR);
+
+        if (XR_FAILED(res) || !pfnXrInitializeLoaderKHR)
+        {
+            TRACELOG(LOG_ERROR, "XR: Failed to get loader entrypoint. (%d)", res);
+            return false;
+        }
+
+        XrLoaderInitInfoAndroidKHR loaderInfo = {XR_TYPE_LOADER_INIT_INFO_ANDROID_KHR};
+        loaderInfo.applicationVM = android->activity->vm;
+        loaderInfo.applicationContext = android->activity->clazz;
+
+        res = pfnXrInitializeLoaderKHR((XrLoaderInitInfoBaseHeaderKHR *)&loaderInfo);
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_ERROR, "XR: Failed to init loader. (%d)", res);
+            return false;
+        }
+    }
+#endif
+
+    loaderInitialized = true;
+    return true;
+}
+
+static inline bool rlxrIsExtAvailable(const char *name, XrExtensionProperties *exts, uint32_t extCount) {
+    for (int i = 0; i < extCount; i++)
+    {
+        if (strcmp(name, exts[i].extensionName) == 0) return true;
+    }
+
+    return false;
+}
+
+static bool rlxrEnumerateExtensions(XrInstanceCreateInfo *info) {
+    // fetch all available extensions
+
+    XrExtensionProperties *available;
+    uint32_t availableCount;
+
+    XrResult res = xrEnumerateInstanceExtensionProperties(NULL, 0, &availableCount, NULL);
+    if (XR_FAILED(res))
+    {
+        if (!rlxrFormatInitResult(res, info)) TRACELOG(LOG_ERROR, "XR: Failed to get available extensions from runtime (%d)", res);
+        return false;
     }
 
     available = (XrExtensionProperties *)RL_MALLOC(availableCount * sizeof(XrExtensionProperties));
@@ -574,7 +1569,7 @@ static bool rlxrEnumerateExtensions(XrInstanceCreateInfo *info) {
 
     // select wanted extensions from the available exts
 
-    static const char *enabled[3];
+    static const char *enabled[11];
     uint32_t enabledCount = 0;
 
     // feature exts //
@@ -585,6 +1580,64 @@ static bool rlxrEnumerateExtensions(XrInstanceCreateInfo *info) {
         rlxr.ext.localFloor = true;
     }
 
+    if (rlxrIsExtAvailable(XR_FB_DISPLAY_REFRESH_RATE_EXTENSION_NAME, available, availableCount))
+    {
+        enabled[enabledCount++] = XR_FB_DISPLAY_REFRESH_RATE_EXTENSION_NAME;
+        rlxr.ext.displayRefreshRate = true;
+    }
+
+    if (rlxrIsExtAvailable(XR_EXT_PERFORMANCE_SETTINGS_EXTENSION_NAME, available, availableCount))
+    {
+        enabled[enabledCount++] = XR_EXT_PERFORMANCE_SETTINGS_EXTENSION_NAME;
+        rlxr.ext.perfSettings = true;
+    }
+
+    if (rlxrIsExtAvailable(XR_EXT_HAND_TRACKING_EXTENSION_NAME, available, availableCount))
+    {
+        enabled[enabledCount++] = XR_EXT_HAND_TRACKING_EXTENSION_NAME;
+        rlxr.ext.handTracking = true;
+    }
+
+    if (rlxrIsExtAvailable(XR_EXT_EYE_GAZE_INTERACTION_EXTENSION_NAME, available, availableCount))
+    {
+        enabled[enabledCount++] = XR_EXT_EYE_GAZE_INTERACTION_EXTENSION_NAME;
+        rlxr.ext.eyeGaze = true;
+    }
+
+    if (rlxrIsExtAvailable(XR_FB_HAPTIC_PCM_EXTENSION_NAME, available, availableCount))
+    {
+        enabled[enabledCount++] = XR_FB_HAPTIC_PCM_EXTENSION_NAME;
+        rlxr.ext.hapticPcm = true;
+    }
+
+    if (rlxrIsExtAvailable(XR_HTCX_VIVE_TRACKER_INTERACTION_EXTENSION_NAME, available, availableCount))
+    {
+        enabled[enabledCount++] = XR_HTCX_VIVE_TRACKER_INTERACTION_EXTENSION_NAME;
+        rlxr.ext.viveTracker = true;
+    }
+
+#ifdef XR_KHR_locate_spaces
+    if (rlxrIsExtAvailable(XR_KHR_LOCATE_SPACES_EXTENSION_NAME, available, availableCount))
+    {
+        enabled[enabledCount++] = XR_KHR_LOCATE_SPACES_EXTENSION_NAME;
+        rlxr.ext.locateSpaces = true;
+    }
+#endif
+
+#if defined(XR_USE_PLATFORM_WIN32)
+    if (rlxrIsExtAvailable(XR_KHR_WIN32_CONVERT_PERFORMANCE_COUNTER_TIME_EXTENSION_NAME, available, availableCount))
+    {
+        enabled[enabledCount++] = XR_KHR_WIN32_CONVERT_PERFORMANCE_COUNTER_TIME_EXTENSION_NAME;
+        rlxr.ext.convertTime = true;
+    }
+#elif defined(XR_USE_TIMESPEC)
+    if (rlxrIsExtAvailable(XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME, available, availableCount))
+    {
+        enabled[enabledCount++] = XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME;
+        rlxr.ext.convertTime = true;
+    }
+#endif
+
     // platform exts //
 
 #ifdef XR_USE_PLATFORM_ANDROID
@@ -700,6 +1753,88 @@ static bool rlxrInitInstance() {
         return false;
     }
 
+    // get feature ext pfns
+
+    if (rlxr.ext.displayRefreshRate)
+    {
+        xrGetInstanceProcAddr(rlxr.instance, "xrEnumerateDisplayRefreshRatesFB", (PFN_xrVoidFunction *)&rlxr.pfn.EnumerateDisplayRefreshRatesFB);
+        xrGetInstanceProcAddr(rlxr.instance, "xrGetDisplayRefreshRateFB", (PFN_xrVoidFunction *)&rlxr.pfn.GetDisplayRefreshRateFB);
+        res = xrGetInstanceProcAddr(rlxr.instance, "xrRequestDisplayRefreshRateFB", (PFN_xrVoidFunction *)&rlxr.pfn.RequestDisplayRefreshRateFB);
+
+        if (XR_FAILED(res) || !rlxr.pfn.EnumerateDisplayRefreshRatesFB || !rlxr.pfn.GetDisplayRefreshRateFB || !rlxr.pfn.RequestDisplayRefreshRateFB)
+        {
+            TRACELOG(LOG_WARNING, "XR: Failed to fetch display refresh rate functions, refresh rate control disabled (%s)", rlxrFormatResult(res));
+            rlxr.ext.displayRefreshRate = false;
+        }
+    }
+
+    if (rlxr.ext.perfSettings)
+    {
+        res = xrGetInstanceProcAddr(rlxr.instance, "xrPerfSettingsSetPerformanceLevelEXT", (PFN_xrVoidFunction *)&rlxr.pfn.PerfSettingsSetPerformanceLevelEXT);
+
+        if (XR_FAILED(res) || !rlxr.pfn.PerfSettingsSetPerformanceLevelEXT)
+        {
+            TRACELOG(LOG_WARNING, "XR: Failed to fetch performance settings functions, performance levels disabled (%s)", rlxrFormatResult(res));
+            rlxr.ext.perfSettings = false;
+        }
+    }
+
+    if (rlxr.ext.hapticPcm)
+    {
+        res = xrGetInstanceProcAddr(rlxr.instance, "xrGetDeviceSampleRateFB", (PFN_xrVoidFunction *)&rlxr.pfn.GetDeviceSampleRateFB);
+
+        if (XR_FAILED(res) || !rlxr.pfn.GetDeviceSampleRateFB)
+        {
+            TRACELOG(LOG_WARNING, "XR: Failed to fetch xrGetDeviceSampleRateFB, PCM haptics disabled (%s)", rlxrFormatResult(res));
+            rlxr.ext.hapticPcm = false;
+        }
+    }
+
+    if (rlxr.ext.handTracking)
+    {
+        res = xrGetInstanceProcAddr(rlxr.instance, "xrCreateHandTrackerEXT", (PFN_xrVoidFunction *)&rlxr.pfn.CreateHandTrackerEXT);
+        if (XR_SUCCEEDED(res)) res = xrGetInstanceProcAddr(rlxr.instance, "xrDestroyHandTrackerEXT", (PFN_xrVoidFunction *)&rlxr.pfn.DestroyHandTrackerEXT);
+        if (XR_SUCCEEDED(res)) res = xrGetInstanceProcAddr(rlxr.instance, "xrLocateHandJointsEXT", (PFN_xrVoidFunction *)&rlxr.pfn.LocateHandJointsEXT);
+
+        if (XR_FAILED(res) || !rlxr.pfn.CreateHandTrackerEXT || !rlxr.pfn.DestroyHandTrackerEXT || !rlxr.pfn.LocateHandJointsEXT)
+        {
+            TRACELOG(LOG_WARNING, "XR: Failed to fetch hand tracking functions, hand tracking disabled (%s)", rlxrFormatResult(res));
+            rlxr.ext.handTracking = false;
+        }
+    }
+
+#ifdef XR_KHR_locate_spaces
+    if (rlxr.ext.locateSpaces)
+    {
+        res = xrGetInstanceProcAddr(rlxr.instance, "xrLocateSpacesKHR", (PFN_xrVoidFunction *)&rlxr.pfn.LocateSpacesKHR);
+
+        if (XR_FAILED(res) || !rlxr.pfn.LocateSpacesKHR)
+        {
+            TRACELOG(LOG_WARNING, "XR: Failed to fetch xrLocateSpacesKHR, falling back to xrLocateSpace (%s)", rlxrFormatResult(res));
+            rlxr.ext.locateSpaces = false;
+        }
+    }
+#endif
+
+    if (rlxr.ext.convertTime)
+    {
+#if defined(XR_USE_PLATFORM_WIN32)
+        xrGetInstanceProcAddr(rlxr.instance, "xrConvertWin32PerformanceCounterToTimeKHR", (PFN_xrVoidFunction *)&rlxr.pfn.ConvertWin32PerformanceCounterToTimeKHR);
+        res = xrGetInstanceProcAddr(rlxr.instance, "xrConvertTimeToWin32PerformanceCounterKHR", (PFN_xrVoidFunction *)&rlxr.pfn.ConvertTimeToWin32PerformanceCounterKHR);
+        bool loaded = rlxr.pfn.ConvertWin32PerformanceCounterToTimeKHR && rlxr.pfn.ConvertTimeToWin32PerformanceCounterKHR;
+#elif defined(XR_USE_TIMESPEC)
+        xrGetInstanceProcAddr(rlxr.instance, "xrConvertTimespecTimeToTimeKHR", (PFN_xrVoidFunction *)&rlxr.pfn.ConvertTimespecTimeToTimeKHR);
+        res = xrGetInstanceProcAddr(rlxr.instance, "xrConvertTimeToTimespecTimeKHR", (PFN_xrVoidFunction *)&rlxr.pfn.ConvertTimeToTimespecTimeKHR);
+        bool loaded = rlxr.pfn.ConvertTimespecTimeToTimeKHR && rlxr.pfn.ConvertTimeToTimespecTimeKHR;
+#endif
+
+        if (XR_FAILED(res) || !loaded)
+        {
+            TRACELOG(LOG_WARNING, "XR: Failed to fetch time conversion functions, clock conversion disabled (%s)", rlxrFormatResult(res));
+            rlxr.ext.convertTime = false;
+        }
+    }
+
     // get system
 
     XrSystemGetInfo systemInfo = {XR_TYPE_SYSTEM_GET_INFO};
@@ -712,14 +1847,36 @@ static bool rlxrInitInstance() {
         return false;
     }
 
+    XrSystemHandTrackingPropertiesEXT handTrackingProps = {XR_TYPE_SYSTEM_HAND_TRACKING_PROPERTIES_EXT};
+    XrSystemEyeGazeInteractionPropertiesEXT eyeGazeProps = {XR_TYPE_SYSTEM_EYE_GAZE_INTERACTION_PROPERTIES_EXT};
+
     rlxr.systemProps = (XrSystemProperties){XR_TYPE_SYSTEM_PROPERTIES};
+
+    if (rlxr.ext.handTracking)
+    {
+        handTrackingProps.next = rlxr.systemProps.next;
+        rlxr.systemProps.next = &handTrackingProps;
+    }
+
+    if (rlxr.ext.eyeGaze)
+    {
+        eyeGazeProps.next = rlxr.systemProps.next;
+        rlxr.systemProps.next = &eyeGazeProps;
+    }
+
     res = xrGetSystemProperties(rlxr.instance, rlxr.system, &rlxr.systemProps);
+    rlxr.systemProps.next = NULL;
+
     if (XR_FAILED(res))
     {
         TRACELOG(LOG_ERROR, "XR: Failed to get XrSystemProperties (%s)", rlxrFormatResult(res));
         return false;
     }
 
+    // extension enabled, but the system might not have the hardware
+    if (!handTrackingProps.supportsHandTracking) rlxr.ext.handTracking = false;
+    if (!eyeGazeProps.supportsEyeGazeInteraction) rlxr.ext.eyeGaze = false;
+
     // get view configuration(s)
 
     rlxr.viewConfig = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
@@ -745,26 +1902,21 @@ static bool rlxrInitInstance() {
         return false;
     }
 
-    // create action set
+    // create primary action set
 
-    XrActionSetCreateInfo setInfo = {XR_TYPE_ACTION_SET_CREATE_INFO};
-    strncpy(setInfo.actionSetName, "rlxr-primary-set", XR_MAX_ACTION_SET_NAME_SIZE);
-    strncpy(setInfo.localizedActionSetName, RLXR_APP_NAME " Primary Input", XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE);
-    setInfo.priority = 0;
+    if (rlxrCreateActionSet("rlxr-primary-set", RLXR_APP_NAME " Primary Input", 0) != RLXR_PRIMARY_ACTION_SET) return false;
 
-    res = xrCreateActionSet(rlxr.instance, &setInfo, &rlxr.actionSet);
-    if (XR_FAILED(res))
-    {
-        TRACELOG(LOG_ERROR, "XR: Failed to create action set (%s)", rlxrFormatResult(res));
-        return false;
-    }
+    rlxr.currentActionSet = RLXR_PRIMARY_ACTION_SET;
+    rlxrRebuildActiveSets();
 
     // init user paths
 
-    xrStringToPath(rlxr.instance, "/user/hand/left", &rlxr.userPaths[0]);
-    xrStringToPath(rlxr.instance, "/user/hand/right", &rlxr.userPaths[1]);
+    for (int i = 0; i < RLXR_DEVICE_COUNT; i++)
+    {
+        rlxr.userPaths[i] = rlxrInternPath(rlxrDevicePaths[i]);
+    }
 
-    xrStringToPath(rlxr.instance, "/interaction_profiles/khr/simple_controller", &rlxr.currentSuggestProfile);
+    rlxr.currentSuggestProfile = rlxrInternPath("/interaction_profiles/khr/simple_controller");
 
     return true;
 }
@@ -958,6 +2110,8 @@ static bool rlxrInitSession() {
     refInfo.poseInReferenceSpace = (XrPosef){{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
 
     rlxr.referenceType = rlxr.ext.localFloor ? RLXR_REFERENCE_LOCAL_FLOOR : RLXR_REFERENCE_LOCAL;
+    rlxr.referencePose = refInfo.poseInReferenceSpace;
+    rlxr.bakedOffset = refInfo.poseInReferenceSpace;
 
     res = xrCreateReferenceSpace(rlxr.session, &refInfo, &rlxr.referenceSpace);
     if (XR_FAILED(res))
@@ -1145,20 +2299,102 @@ static bool rlxrInitSession() {
         }
     }
 
+    // query display refresh rates
+
+    if (rlxr.ext.displayRefreshRate)
+    {
+        res = rlxr.pfn.EnumerateDisplayRefreshRatesFB(rlxr.session, 0, &rlxr.refreshRateCount, NULL);
+        if (XR_SUCCEEDED(res) && rlxr.refreshRateCount != 0)
+        {
+            rlxr.refreshRates = (float *)RL_MALLOC(rlxr.refreshRateCount * sizeof(float));
+            res = rlxr.pfn.EnumerateDisplayRefreshRatesFB(rlxr.session, rlxr.refreshRateCount, &rlxr.refreshRateCount, rlxr.refreshRates);
+        }
+
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_WARNING, "XR: Failed to enumerate display refresh rates (%s)", rlxrFormatResult(res));
+            rlxr.refreshRateCount = 0;
+        }
+
+        res = rlxr.pfn.GetDisplayRefreshRateFB(rlxr.session, &rlxr.refreshRate);
+        if (XR_FAILED(res))
+        {
+            rlxr.refreshRate = 0.f;
+        }
+    }
+
+    // create hand trackers
+
+    if (rlxr.ext.handTracking)
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            XrHandTrackerCreateInfoEXT trackerInfo = {XR_TYPE_HAND_TRACKER_CREATE_INFO_EXT};
+            trackerInfo.hand = i == 0 ? XR_HAND_LEFT_EXT : XR_HAND_RIGHT_EXT;
+            trackerInfo.handJointSet = XR_HAND_JOINT_SET_DEFAULT_EXT;
+
+            res = rlxr.pfn.CreateHandTrackerEXT(rlxr.session, &trackerInfo, &rlxr.handTrackers[i]);
+            if (XR_FAILED(res))
+            {
+                TRACELOG(LOG_WARNING, "XR: Failed to create hand tracker, hand tracking disabled (%s)", rlxrFormatResult(res));
+                rlxr.ext.handTracking = false;
+                break;
+            }
+        }
+    }
+
     // log success and device info
 
     TRACELOG(LOG_INFO, "XR: OpenXR session initialized successfully");
     TRACELOG(LOG_INFO, "XR: System information:");
     TRACELOG(LOG_INFO, "    > Device:          %s", rlxr.systemProps.systemName);
     TRACELOG(LOG_INFO, "    > View size:       %d x %d", rlxr.viewProps[0].recommendedImageRectWidth, rlxr.viewProps[0].recommendedImageRectHeight);
+    if (rlxr.refreshRate > 0.f) TRACELOG(LOG_INFO, "    > Refresh rate:    %.1f Hz (%d available)", rlxr.refreshRate, rlxr.refreshRateCount);
     TRACELOG(LOG_INFO, "    > Runtime Name:    %s", rlxr.instanceProps.runtimeName);
     TRACELOG(LOG_INFO, "    > Runtime Version: %d.%d.%d", XR_VERSION_MAJOR(rlxr.instanceProps.runtimeVersion), XR_VERSION_MINOR(rlxr.instanceProps.runtimeVersion), XR_VERSION_PATCH(rlxr.instanceProps.runtimeVersion));
 
     return true;
 }
 
+static void rlxrInitEyeGaze() {
+    // creates the internal gaze action in its own always-active set, bound to the eye gaze interaction profile
+    // note: the set is kept out of rlxr.actionSets, so it can't be disabled nor shift the indices of app sets
+
+    rlxr.gazeAction = RLXR_NULL_ACTION;
+    if (!rlxr.ext.eyeGaze) return;
+
+    XrActionSetCreateInfo setInfo = {XR_TYPE_ACTION_SET_CREATE_INFO};
+    snprintf(setInfo.actionSetName, XR_MAX_ACTION_SET_NAME_SIZE, "%s", "rlxr-internal-set");
+    snprintf(setInfo.localizedActionSetName, XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE, "%s", RLXR_APP_NAME " Eye Gaze");
+
+    // (replays have no runtime, only the action bookkeeping is kept)
+    if (!rlxr.replay.file)
+    {
+        XrResult res = xrCreateActionSet(rlxr.instance, &setInfo, &rlxr.internalActionSet);
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_ERROR, "XR: Failed to create internal action set (%s)", rlxrFormatResult(res));
+            rlxr.internalActionSet = XR_NULL_HANDLE;
+            return;
+        }
+
+        rlxrRebuildActiveSets();
+    }
+
+    rlxr.currentActionSet = RLXR_INTERNAL_ACTION_SET;
+    rlxr.gazeAction = rlLoadAction("rlxr-eye-gaze", RLXR_TYPE_POSE, RLXR_DEVICE_EYES);
+    rlxr.currentActionSet = RLXR_PRIMARY_ACTION_SET;
+
+    XrPath userProfile = rlxr.currentSuggestProfile;
+
+    rlSuggestProfile("/interaction_profiles/ext/eye_gaze_interaction");
+    rlSuggestBindingPro(rlxr.gazeAction, RLXR_DEVICE_EYES, "/input/gaze_ext/pose");
+
+    rlxr.currentSuggestProfile = userProfile;
+}
+
 bool InitXr() {
-    if (rlxr.instance) return true;
+    if (rlxr.instance || rlxr.replay.file) return true;
 
     memset(&rlxr, 0, sizeof(rlxr));
 
@@ -1166,8 +2402,12 @@ bool InitXr() {
     if (!rlxrInitInstance()) return false;
     if (!rlxrInitSession()) return false;
 
+    rlxrInitEyeGaze();
+
     rlxr.refPosition = (Vector3){0.f, 0.f, 0.f};
     rlxr.refOrientation = (Quaternion){0.f, 0.f, 0.f, 1.f};
+    rlxr.offsetPosition = rlxr.refPosition;
+    rlxr.offsetOrientation = rlxr.refOrientation;
 
     rlxr.frameActive = false;
     rlxr.viewActiveIndex = ~0;
@@ -1175,20 +2415,80 @@ bool InitXr() {
     return true;
 }
 
+static void rlxrFreeActionState() {
+    // frees the action bookkeeping, runtime handles must already be destroyed
+
+    for (int i = 0; i < rlxr.actionCount; i++) RL_FREE(rlxr.actions[i].actionSpaces);
+
+    RL_FREE(rlxr.actions);
+    RL_FREE(rlxr.actionTable);
+    RL_FREE(rlxr.actionSamples);
+    RL_FREE(rlxr.rawValues);
+    RL_FREE(rlxr.locateSpaces);
+    RL_FREE(rlxr.locateResults);
+    RL_FREE(rlxr.locateVelocities);
+    RL_FREE(rlxr.locateTargets);
+#ifdef XR_KHR_locate_spaces
+    RL_FREE(rlxr.locateData);
+    RL_FREE(rlxr.locateVelocityData);
+#endif
+    RL_FREE(rlxr.bindings);
+
+    for (unsigned int i = 0; i < rlxr.hapticEffectCount; i++) RL_FREE(rlxr.hapticEffects[i].samples);
+    RL_FREE(rlxr.hapticEffects);
+    RL_FREE(rlxr.hapticTargets);
+
+    RL_FREE(rlxr.actionSets);
+    RL_FREE(rlxr.activeSets);
+
+    RL_FREE(rlxr.filters.samples);
+    RL_FREE(rlxr.filters.primed);
+    RL_FREE(rlxr.filters.raw);
+    RL_FREE(rlxr.filters.value);
+    RL_FREE(rlxr.filters.deriv);
+    RL_FREE(rlxr.filters.param0);
+    RL_FREE(rlxr.filters.param1);
+
+    for (int i = 0; i < RLXR_SNAPSHOT_BUFFERS; i++) RL_FREE(rlxr.snapshots[i].samples);
+    rlxr.latestSnapshot = 0;
+
+    rlxrFreeInternedPaths();
+}
+
 void CloseXr() {
+    if (rlxr.replay.file)
+    {
+        // no runtime objects to destroy
+
+        RL_FREE(rlxr.jobs);
+        StopXrLatencyLog();
+
+        fclose(rlxr.replay.file);
+        RL_FREE(rlxr.replay.buffer);
+        RL_FREE(rlxr.views);
+
+        rlxrFreeActionState();
+
+        rlxr.replay.file = NULL;
+        TRACELOG(LOG_INFO, "XR: Replay closed");
+        return;
+    }
+
     if (!rlxr.instance) return;
 
     for (int i = 0; i < rlxr.actionCount; i++)
     {
-        for (int j = 0; j < RLXR_MAX_SPACES_PER_ACTION; j++)
+        if (rlxr.actions[i].actionSpaces)
         {
-            if (rlxr.actions[i].actionSpaces[j] != XR_NULL_HANDLE) xrDestroySpace(rlxr.actions[i].actionSpaces[j]);
+            for (unsigned int j = 0; j < rlxr.actions[i].deviceCount; j++) xrDestroySpace(rlxr.actions[i].actionSpaces[j]);
         }
 
         xrDestroyAction(rlxr.actions[i].action);
     }
-    RL_FREE(rlxr.actions);
-    RL_FREE(rlxr.bindings);
+    RL_FREE(rlxr.jobs);
+
+    StopXrLatencyLog();
+    StopXrRecording();
 
     for (int i = 0; i < rlxr.viewCount; i++)
     {
@@ -1207,11 +2507,25 @@ void CloseXr() {
     RL_FREE(rlxr.projectionViews);
     RL_FREE(rlxr.views);
     RL_FREE(rlxr.viewBufs);
+    RL_FREE(rlxr.refreshRates);
+
+    for (int i = 0; i < 2; i++)
+    {
+        if (rlxr.handTrackers[i] != XR_NULL_HANDLE) rlxr.pfn.DestroyHandTrackerEXT(rlxr.handTrackers[i]);
+    }
 
     xrDestroySpace(rlxr.viewSpace);
     xrDestroySpace(rlxr.referenceSpace);
+    if (rlxr.stageSpace != XR_NULL_HANDLE) xrDestroySpace(rlxr.stageSpace);
+
+    for (unsigned int i = 0; i < rlxr.actionSetCount; i++)
+    {
+        xrDestroyActionSet(rlxr.actionSets[i].actionSet);
+    }
+
+    if (rlxr.internalActionSet != XR_NULL_HANDLE) xrDestroyActionSet(rlxr.internalActionSet);
 
-    xrDestroyActionSet(rlxr.actionSet);
+    rlxrFreeActionState();
 
     xrDestroySession(rlxr.session);
     xrDestroyInstance(rlxr.instance);
@@ -1220,1023 +2534,3600 @@ void CloseXr() {
     TRACELOG(LOG_INFO, "XR: Session closed successfully");
 }
 
-static void submitSuggestedBindings() {
-    assert(!rlxr.actionSetAttached);
+static void rlxrReserveLocate(unsigned int count) {
+    // grows the batched locate scratch buffers to fit at least [count] spaces
+
+    if (count <= rlxr.locateCap) return;
+
+    rlxr.locateCap = count;
+    rlxr.locateSpaces = (XrSpace *)RL_REALLOC(rlxr.locateSpaces, count * sizeof(XrSpace));
+    rlxr.locateResults = (XrSpaceLocation *)RL_REALLOC(rlxr.locateResults, count * sizeof(XrSpaceLocation));
+    rlxr.locateVelocities = (XrSpaceVelocity *)RL_REALLOC(rlxr.locateVelocities, count * sizeof(XrSpaceVelocity));
+    rlxr.locateTargets = (rlxrActionSample **)RL_REALLOC(rlxr.locateTargets, count * sizeof(rlxrActionSample *));
+#ifdef XR_KHR_locate_spaces
+    rlxr.locateData = (XrSpaceLocationDataKHR *)RL_REALLOC(rlxr.locateData, count * sizeof(XrSpaceLocationDataKHR));
+    rlxr.locateVelocityData = (XrSpaceVelocityDataKHR *)RL_REALLOC(rlxr.locateVelocityData, count * sizeof(XrSpaceVelocityDataKHR));
+#endif
+}
 
-    if (rlxr.bindingCount != 0)
+static rlxrLocateCacheEntry *rlxrFindLocateCacheEntry(XrSpace space, XrTime time, bool insert) {
+    // returns the cache entry of (space, time), or the entry to overwrite with it if [insert] is set, probing a few slots
+
+    uint64_t hash = ((uint64_t)(uintptr_t)space ^ (uint64_t)time) * 0x9e3779b97f4a7c15ull;
+    unsigned int mask = RLXR_LOCATE_CACHE_SIZE - 1;
+    unsigned int first = (unsigned int)(hash >> 32) & mask;
+
+    for (unsigned int i = 0; i < 4; i++)
     {
-        XrInteractionProfileSuggestedBinding profileInfo = {XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
-        profileInfo.interactionProfile = rlxr.currentSuggestProfile;
-        profileInfo.countSuggestedBindings = rlxr.bindingCount;
-        profileInfo.suggestedBindings = rlxr.bindings;
+        rlxrLocateCacheEntry *entry = &rlxr.locateCache[(first + i) & mask];
+        bool stale = entry->generation != rlxr.locateGeneration || entry->space == XR_NULL_HANDLE;
 
-        XrResult res = xrSuggestInteractionProfileBindings(rlxr.instance, &profileInfo);
-        if (XR_FAILED(res))
-        {
-            TRACELOG(LOG_ERROR, "XR: Failed to suggest bindings, input will probably not work (%s)", rlxrFormatResult(res));
-        }
+        if (!stale && entry->space == space && entry->time == time) return entry;
+        if (stale && insert) return entry;
     }
 
-    rlxr.bindingCount = 0;
+    return insert ? &rlxr.locateCache[first] : NULL;
 }
 
-void UpdateXr() {
-    // attach action set (first update call)
-
-    if (!rlxr.actionSetAttached)
+static void rlxrCacheLocations(const XrSpace *spaces, unsigned int count, XrTime time, const XrSpaceLocation *locations, const XrSpaceVelocity *velocities) {
+    for (unsigned int i = 0; i < count; i++)
     {
-        // suggest bindings
-
-        submitSuggestedBindings();
+        rlxrLocateCacheEntry *entry = rlxrFindLocateCacheEntry(spaces[i], time, true);
+
+        entry->space = spaces[i];
+        entry->time = time;
+        entry->generation = rlxr.locateGeneration;
+        entry->location = locations[i];
+        entry->hasVelocity = velocities != NULL;
+        if (velocities) entry->velocity = velocities[i];
+    }
+}
 
-        // attach
+static void rlxrLocateSpaces(const XrSpace *spaces, unsigned int count, XrTime time, XrSpaceLocation *locations, XrSpaceVelocity *velocities) {
+    // locates [count] spaces relative to the reference space, in a single call if XR_KHR_locate_spaces is supported
+    // velocities are located in the same call when [velocities] is not NULL
+    // all results are cached until the next UpdateXr, single space queries are answered from the cache
 
-        XrSessionActionSetsAttachInfo attachInfo = {XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
-        attachInfo.countActionSets = 1;
-        attachInfo.actionSets = &rlxr.actionSet;
+    if (count == 1)
+    {
+        rlxrLocateCacheEntry *entry = rlxrFindLocateCacheEntry(spaces[0], time, false);
 
-        XrResult res = xrAttachSessionActionSets(rlxr.session, &attachInfo);
-        if (XR_FAILED(res))
-        {
-            TRACELOG(LOG_ERROR, "XR: Failed to attach action set, input will probably not work (%s)", rlxrFormatResult(res));
-        } else if (rlxr.actionCount != 0)
+        if (entry && (entry->hasVelocity || !velocities))
         {
-            TRACELOG(LOG_INFO, "XR: %d actions attached successfully", rlxr.actionCount);
+            locations[0] = entry->location;
+            if (velocities) velocities[0] = entry->velocity;
+            return;
         }
-
-        rlxr.actionSetAttached = true;
     }
 
-    // poll events
-
-    XrEventDataBuffer ev = {XR_TYPE_EVENT_DATA_BUFFER};
-    for (; xrPollEvent(rlxr.instance, &ev) == XR_SUCCESS; ev = (XrEventDataBuffer){XR_TYPE_EVENT_DATA_BUFFER})
+#ifdef XR_KHR_locate_spaces
+    if (rlxr.ext.locateSpaces && count > 1)
     {
-        switch (ev.type)
-        {
-        case XR_TYPE_EVENT_DATA_EVENTS_LOST:
-            TRACELOG(LOG_WARNING, "XR: Event buffer overflow, %d events lost; UpdateXr might be getting called too little", ((XrEventDataEventsLost *)&ev)->lostEventCount);
-            break;
-
-        case XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING:
-            TRACELOG(LOG_ERROR, "XR: Instance loss pending; rlxr disconnected.");
+        // note: buffers are only grown, [spaces] may point into rlxr.locateSpaces (which then already fits [count])
+        rlxrReserveLocate(count);
 
-            rlxr.state = XR_SESSION_STATE_LOSS_PENDING;
-            break;
+        XrSpaceLocationDataKHR *data = rlxr.locateData;
+        XrSpaceVelocityDataKHR *velocityData = velocities ? rlxr.locateVelocityData : NULL;
 
-        case XR_TYPE_EVENT_DATA_REFERENCE_SPACE_CHANGE_PENDING:
-            break;
+        XrSpacesLocateInfoKHR locateInfo = {XR_TYPE_SPACES_LOCATE_INFO_KHR};
+        locateInfo.baseSpace = rlxr.referenceSpace;
+        locateInfo.time = time;
+        locateInfo.spaceCount = count;
+        locateInfo.spaces = spaces;
 
-        case XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED:
-        {
-            XrEventDataSessionStateChanged *state = (XrEventDataSessionStateChanged *)&ev;
+        XrSpaceVelocitiesKHR spaceVelocities = {XR_TYPE_SPACE_VELOCITIES_KHR};
+        spaceVelocities.velocityCount = count;
+        spaceVelocities.velocities = velocityData;
 
-            if (state->state == XR_SESSION_STATE_READY)
-            {
-                // session ready, begin session with view configuration
-                XrSessionBeginInfo beginInfo = {XR_TYPE_SESSION_BEGIN_INFO};
-                beginInfo.primaryViewConfigurationType = rlxr.viewConfig;
+        XrSpaceLocationsKHR spaceLocations = {XR_TYPE_SPACE_LOCATIONS_KHR};
+        spaceLocations.next = velocities ? &spaceVelocities : NULL;
+        spaceLocations.locationCount = count;
+        spaceLocations.locations = data;
 
-                XrResult res = xrBeginSession(rlxr.session, &beginInfo);
-                if (XR_FAILED(res))
-                {
-                    TRACELOG(LOG_ERROR, "XR: Failed to begin session (%s)", rlxrFormatResult(res));
-                    break;
-                }
-#ifndef RLXR_ALLOW_EVENT_WAITING
-                // prevent blocking frame loop on events when running in xr
-                SetWindowState(FLAG_WINDOW_ALWAYS_RUN);
-#endif
-            }
-            if (state->state == XR_SESSION_STATE_STOPPING)
-            {
-                XrResult res = xrEndSession(rlxr.session);
-                if (XR_FAILED(res))
-                {
-                    TRACELOG(LOG_ERROR, "XR: Failed to end session (%s)", rlxrFormatResult(res));
-                    break;
-                }
-#ifndef RLXR_ALLOW_EVENT_WAITING
-                // reallow blocking frame loop on events
-                ClearWindowState(FLAG_WINDOW_ALWAYS_RUN);
-#endif
-            }
-            if (state->state == XR_SESSION_STATE_EXITING)
+        XrResult res = rlxr.pfn.LocateSpacesKHR(rlxr.session, &locateInfo, &spaceLocations);
+        if (XR_SUCCEEDED(res))
+        {
+            for (unsigned int i = 0; i < count; i++)
             {
-                TRACELOG(LOG_INFO, "XR: Session exiting; rlxr disconnected.");
+                locations[i] = (XrSpaceLocation){XR_TYPE_SPACE_LOCATION};
+                locations[i].locationFlags = data[i].locationFlags;
+                locations[i].pose = data[i].pose;
 
-                rlxr.state = XR_SESSION_STATE_EXITING;
-                break;
-            }
-            if (state->state == XR_SESSION_STATE_LOSS_PENDING)
-            {
-                TRACELOG(LOG_ERROR, "XR: Session loss pending; rlxr disconnected.");
+                if (!velocities) continue;
 
-                rlxr.state = XR_SESSION_STATE_LOSS_PENDING;
-                break;
+                velocities[i] = (XrSpaceVelocity){XR_TYPE_SPACE_VELOCITY};
+                velocities[i].velocityFlags = velocityData[i].velocityFlags;
+                velocities[i].linearVelocity = velocityData[i].linearVelocity;
+                velocities[i].angularVelocity = velocityData[i].angularVelocity;
             }
 
-            TRACELOG(LOG_DEBUG, "XR: Session state changed: %d -> %d", rlxr.state, state->state);
-            rlxr.state = state->state;
-
-            break;
+            rlxrCacheLocations(spaces, count, time, locations, velocities);
+            return;
         }
 
-        default:
-            TRACELOG(LOG_DEBUG, "XR: received unknown event type %d, ignoring", ev.type);
-            break;
-        }
+        TRACELOG(LOG_ERROR, "XR: Failed to locate spaces (%s)", rlxrFormatResult(res));
     }
+#endif
 
-    if (rlxrIsSessionRunning())
+    for (unsigned int i = 0; i < count; i++)
     {
-        // sync with xr runtime
-
-        rlxr.frameState.type = XR_TYPE_FRAME_STATE;
-        XrFrameWaitInfo waitInfo = {XR_TYPE_FRAME_WAIT_INFO};
+        locations[i] = (XrSpaceLocation){XR_TYPE_SPACE_LOCATION};
 
-        XrResult res = xrWaitFrame(rlxr.session, &waitInfo, &rlxr.frameState);
-        if (XR_FAILED(res))
+        if (velocities)
         {
-            TRACELOG(LOG_ERROR, "XR: Failed to wait for a frame (%s)", rlxrFormatResult(res));
+            velocities[i] = (XrSpaceVelocity){XR_TYPE_SPACE_VELOCITY};
+            locations[i].next = &velocities[i];
         }
 
-        // sync action set
+        XrResult res = xrLocateSpace(spaces[i], rlxr.referenceSpace, time, &locations[i]);
+        locations[i].next = NULL;
 
-        XrActiveActionSet activeSet = {};
-        activeSet.actionSet = rlxr.actionSet;
-        activeSet.subactionPath = XR_NULL_PATH;
-
-        XrActionsSyncInfo syncInfo = {XR_TYPE_ACTIONS_SYNC_INFO};
-        syncInfo.countActiveActionSets = 1;
-        syncInfo.activeActionSets = &activeSet;
-
-        res = xrSyncActions(rlxr.session, &syncInfo);
         if (XR_FAILED(res))
         {
-            TRACELOG(LOG_WARNING, "XR: Failed to sync actions (%s)", rlxrFormatResult(res));
+            TRACELOG(LOG_ERROR, "XR: Failed to locate space (%s)", rlxrFormatResult(res));
+            locations[i].locationFlags = 0;
+            if (velocities) velocities[i].velocityFlags = 0;
         }
     }
-}
-
-bool IsXrConnected() {
-    if (!rlxr.instance) return false;
-    return rlxr.state != XR_SESSION_STATE_LOSS_PENDING && rlxr.state != XR_SESSION_STATE_EXITING;
-}
 
-bool IsXrFocused() {
-    if (!rlxr.instance) return false;
-    return rlxr.state == XR_SESSION_STATE_FOCUSED;
+    rlxrCacheLocations(spaces, count, time, locations, velocities);
 }
 
-rlXrState GetXrState() {
-    if (!rlxr.instance) return RLXR_STATE_UNKNOWN;
-
-    switch (rlxr.state)
-    {
-    case XR_SESSION_STATE_IDLE:
-    case XR_SESSION_STATE_READY:
-    case XR_SESSION_STATE_STOPPING:
-        return RLXR_STATE_IDLE;
+static void rlxrSampleActionState(unsigned int action, int slot, rlxrActionSample *sample) {
+    rlxrAction *ac = &rlxr.actions[action];
+    memset(sample, 0, sizeof(rlxrActionSample));
 
-    case XR_SESSION_STATE_SYNCHRONIZED:
-        return RLXR_STATE_SYNCHRONIZED;
+    XrActionStateGetInfo getInfo = {XR_TYPE_ACTION_STATE_GET_INFO};
+    getInfo.action = ac->action;
+    getInfo.subactionPath = rlxr.userPaths[slot];
 
-    case XR_SESSION_STATE_VISIBLE:
-        return RLXR_STATE_VISIBLE;
+    XrResult res;
 
-    case XR_SESSION_STATE_FOCUSED:
-        return RLXR_STATE_FOCUSED;
+    switch (ac->type)
+    {
+    case RLXR_TYPE_BOOLEAN:
+    {
+        XrActionStateBoolean state = {XR_TYPE_ACTION_STATE_BOOLEAN};
+        res = xrGetActionStateBoolean(rlxr.session, &getInfo, &state);
 
-    default:
-        return RLXR_STATE_UNKNOWN;
+        sample->value.b = state.currentState;
+        sample->active = state.isActive;
+        sample->changed = state.changedSinceLastSync;
+        sample->lastChangeTime = state.lastChangeTime;
+        break;
     }
-}
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition - Space and Poses
-//----------------------------------------------------------------------------------
+    case RLXR_TYPE_FLOAT:
+    {
+        XrActionStateFloat state = {XR_TYPE_ACTION_STATE_FLOAT};
+        res = xrGetActionStateFloat(rlxr.session, &getInfo, &state);
 
-static rlPose xrPoseToRlPose(XrPosef xrPose, bool position, bool orientation) {
-    rlPose pose;
-    pose.position = (Vector3){0.f, 0.f, 0.f};
-    pose.orientation = (Quaternion){0.f, 0.f, 0.f, 1.f};
-    pose.isPositionValid = false;
-    pose.isOrientationValid = false;
+        sample->value.f = state.currentState;
+        sample->active = state.isActive;
+        sample->changed = state.changedSinceLastSync;
+        sample->lastChangeTime = state.lastChangeTime;
+        break;
+    }
 
-    if (position)
+    case RLXR_TYPE_VECTOR2F:
     {
-        pose.position = (Vector3){xrPose.position.x, xrPose.position.y, xrPose.position.z};
-        pose.position = Vector3Add(rlxr.refPosition, pose.position);
-        pose.isPositionValid = true;
+        XrActionStateVector2f state = {XR_TYPE_ACTION_STATE_VECTOR2F};
+        res = xrGetActionStateVector2f(rlxr.session, &getInfo, &state);
+
+        sample->value.v = (Vector2){state.currentState.x, state.currentState.y};
+        sample->active = state.isActive;
+        sample->changed = state.changedSinceLastSync;
+        sample->lastChangeTime = state.lastChangeTime;
+        break;
     }
 
-    if (orientation)
+    case RLXR_TYPE_POSE:
     {
-        pose.orientation = (Quaternion){xrPose.orientation.x, xrPose.orientation.y, xrPose.orientation.z, xrPose.orientation.w};
-        pose.orientation = QuaternionMultiply(rlxr.refOrientation, pose.orientation);
-        pose.isOrientationValid = true;
-    }
+        // note: the pose itself is located separately (see rlxrSampleAction / rlxrUpdateActionSamples)
 
-    return pose;
-}
+        XrActionStatePose state = {XR_TYPE_ACTION_STATE_POSE};
+        res = xrGetActionStatePose(rlxr.session, &getInfo, &state);
 
-rlPose GetXrViewPose() {
-    XrSpaceLocation location = {XR_TYPE_SPACE_LOCATION};
+        sample->active = state.isActive;
+        break;
+    }
+
+    default:
+        return; // output actions have no state
+    }
 
-    XrResult res = xrLocateSpace(rlxr.viewSpace, rlxr.referenceSpace, rlxr.frameState.predictedDisplayTime, &location);
     if (XR_FAILED(res))
     {
-        TRACELOG(LOG_ERROR, "XR: failed to locate view space (%s)", rlxrFormatResult(res));
+        TRACELOG(LOG_ERROR, "XR: Failed to get action state (action: %d; result: %s)", action, rlxrFormatResult(res));
+        sample->active = false;
     }
+}
 
-    return xrPoseToRlPose(location.pose, location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT, location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT);
-}
+static void rlxrSampleAction(unsigned int action, int slot, XrTime time, rlxrActionSample *sample) {
+    rlxrSampleActionState(action, slot, sample);
 
-void SetXrPosition(Vector3 pos) {
-    rlxr.refPosition = pos;
-}
+    if (rlxr.actions[action].type == RLXR_TYPE_POSE && sample->active)
+    {
+        // locate pose space
 
-void SetXrOrientation(Quaternion quat) {
-    rlxr.refOrientation = quat;
-}
+        XrSpaceLocation location;
+        XrSpaceVelocity velocity;
+        rlxrLocateSpaces(&rlxr.actions[action].actionSpaces[rlxrActionDeviceIndex(&rlxr.actions[action], slot)], 1, time, &location, &velocity);
 
-rlPose GetXrPose() {
-    return (rlPose){rlxr.refPosition, rlxr.refOrientation};
+        sample->locationFlags = location.locationFlags;
+        sample->pose = location.pose;
+        sample->velocityFlags = velocity.velocityFlags;
+        sample->linearVelocity = velocity.linearVelocity;
+        sample->angularVelocity = velocity.angularVelocity;
+    }
 }
 
-bool SetXrReference(rlReferenceType type) {
-    XrReferenceSpaceCreateInfo refInfo = {XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
-    refInfo.poseInReferenceSpace = (XrPosef){{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+static void rlxrPushInputEvent(unsigned int action, int slot, const rlInputValue *rawValue, const rlxrActionSample *sample) {
+    // appends an event to the input ring buffer, keeping the queue sorted by change time
+    // note: [rawValue] is the unfiltered value of the last sync, the snapshot one may have been filtered since
 
-    switch (type)
+    if (rlxr.inputEventCount == RLXR_MAX_INPUT_EVENTS)
     {
-    case RLXR_REFERENCE_LOCAL:
-        refInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
-        break;
+        if (rlxr.inputEventsDropped++ == 0) TRACELOG(LOG_WARNING, "XR: Input event queue full, dropping oldest events");
 
-    case RLXR_REFERENCE_LOCAL_FLOOR:
-        refInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_LOCAL_FLOOR_EXT;
-        break;
-
-    case RLXR_REFERENCE_STAGE:
-        refInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_STAGE;
-        break;
-    }
-
-    XrSpace newSpace;
-    XrResult res = xrCreateReferenceSpace(rlxr.session, &refInfo, &newSpace);
-    if (XR_FAILED(res))
+        rlxr.inputEventHead = (rlxr.inputEventHead + 1) % RLXR_MAX_INPUT_EVENTS;
+        rlxr.inputEventCount--;
+    } else if (rlxr.inputEventsDropped != 0)
     {
-        TRACELOG(LOG_WARNING, "XR: Failed to switch reference type (%s)", rlxrFormatResult(res));
-        return false;
+        TRACELOG(LOG_WARNING, "XR: Input event queue overflow ended, %u events dropped", rlxr.inputEventsDropped);
+        rlxr.inputEventsDropped = 0;
     }
 
-    if (rlxr.referenceSpace)
+    rlInputEvent event = {};
+    event.action = action;
+    event.device = (rlActionDevices)(1 << slot);
+    event.type = rlxr.actions[action].type;
+    event.oldValue = *rawValue;
+    memcpy(&event.newValue, &sample->value, sizeof(rlInputValue));
+    event.time = sample->lastChangeTime;
+
+    // insert sorted (actions are snapshot in load order, not in the order they changed)
+
+    unsigned int i = rlxr.inputEventCount++;
+    while (i > 0)
     {
-        xrDestroySpace(rlxr.referenceSpace);
-    }
+        rlInputEvent *prev = &rlxr.inputEvents[(rlxr.inputEventHead + i - 1) % RLXR_MAX_INPUT_EVENTS];
+        if (prev->time <= event.time) break;
 
-    rlxr.referenceSpace = newSpace;
-    rlxr.referenceType = type;
+        rlxr.inputEvents[(rlxr.inputEventHead + i) % RLXR_MAX_INPUT_EVENTS] = *prev;
+        i--;
+    }
 
-    return true;
+    rlxr.inputEvents[(rlxr.inputEventHead + i) % RLXR_MAX_INPUT_EVENTS] = event;
 }
 
-rlReferenceType GetXrReference() {
-    return rlxr.referenceType;
-}
+static void rlxrUpdateActionSamples() {
+    // fetch all action states, collecting active pose spaces
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition - View Rendering
-//----------------------------------------------------------------------------------
+    rlxr.locateCount = 0;
 
-// =============================================================================
-// math code adapted from
-// https://github.com/KhronosGroup/OpenXR-SDK-Source/blob/master/src/common/xr_linear.h
-// Copyright (c) 2017 The Khronos Group Inc.
-// Copyright (c) 2016 Oculus VR, LLC.
-// SPDX-License-Identifier: Apache-2.0
-// =============================================================================
+    for (unsigned int i = 0; i < rlxr.actionCount; i++)
+    {
+        rlxrAction *ac = &rlxr.actions[i];
+        bool setActive = ac->set == RLXR_INTERNAL_ACTION_SET || rlxr.actionSets[ac->set].active;
 
-typedef enum {
-    GRAPHICS_VULKAN,
-    GRAPHICS_OPENGL,
-    GRAPHICS_OPENGL_ES
-} GraphicsAPI;
+        unsigned int deviceIndex = 0;
 
-inline static void
-XrMatrix4x4f_CreateProjectionFov(Matrix *result,
-                                 GraphicsAPI graphicsApi,
-                                 const XrFovf fov,
-                                 const float nearZ,
-                                 const float farZ) {
-    const float tanAngleLeft = tanf(fov.angleLeft);
-    const float tanAngleRight = tanf(fov.angleRight);
+        for (int slot = 0; slot < RLXR_DEVICE_COUNT; slot++)
+        {
+            if (!(ac->subpaths & (1 << slot))) continue;
 
-    const float tanAngleDown = tanf(fov.angleDown);
-    const float tanAngleUp = tanf(fov.angleUp);
+            unsigned int device = deviceIndex++;
+            rlxrActionSample *sample = &rlxr.actionSamples[ac->sampleOffset + device];
 
-    const float tanAngleWidth = tanAngleRight - tanAngleLeft;
+            rlInputValue *rawValue = &rlxr.rawValues[ac->sampleOffset + device];
 
-    // Set to tanAngleDown - tanAngleUp for a clip space with positive Y
-    // down (Vulkan). Set to tanAngleUp - tanAngleDown for a clip space with
-    // positive Y up (OpenGL / D3D / Metal).
-    const float tanAngleHeight =
-        graphicsApi == GRAPHICS_VULKAN ? (tanAngleDown - tanAngleUp) : (tanAngleUp - tanAngleDown);
+            if (!setActive)
+            {
+                // not synced, skip the runtime query
+                *sample = (rlxrActionSample){0};
+                *rawValue = (rlInputValue){0};
+                continue;
+            }
 
-    // Set to nearZ for a [-1,1] Z clip space (OpenGL / OpenGL ES).
-    // Set to zero for a [0,1] Z clip space (Vulkan / D3D / Metal).
-    const float offsetZ =
-        (graphicsApi == GRAPHICS_OPENGL || graphicsApi == GRAPHICS_OPENGL_ES) ? nearZ : 0;
+            rlxrSampleActionState(i, slot, sample);
 
-    if (farZ <= nearZ)
-    {
-        // place the far plane at infinity
-        result->m0 = 2 / tanAngleWidth;
-        result->m4 = 0;
-        result->m8 = (tanAngleRight + tanAngleLeft) / tanAngleWidth;
-        result->m12 = 0;
+            if (sample->changed && ac->type != RLXR_TYPE_POSE) rlxrPushInputEvent(i, slot, rawValue, sample);
+            memcpy(rawValue, &sample->value, sizeof(rlInputValue));
 
-        result->m1 = 0;
-        result->m5 = 2 / tanAngleHeight;
-        result->m9 = (tanAngleUp + tanAngleDown) / tanAngleHeight;
-        result->m13 = 0;
+            if (ac->type == RLXR_TYPE_POSE && sample->active)
+            {
+                rlxrReserveLocate(rlxr.locateCount + 2); // (+1 for the view space)
 
-        result->m2 = 0;
-        result->m6 = 0;
-        result->m10 = -1;
-        result->m14 = -(nearZ + offsetZ);
+                rlxr.locateSpaces[rlxr.locateCount] = ac->actionSpaces[device];
+                rlxr.locateTargets[rlxr.locateCount] = sample;
+                rlxr.locateCount++;
+            }
+        }
+    }
 
-        result->m3 = 0;
-        result->m7 = 0;
-        result->m11 = -1;
-        result->m15 = 0;
-    } else
-    {
-        // normal projection
-        result->m0 = 2 / tanAngleWidth;
-        result->m4 = 0;
-        result->m8 = (tanAngleRight + tanAngleLeft) / tanAngleWidth;
-        result->m12 = 0;
+    // locate all pose spaces together with the view space
 
-        result->m1 = 0;
-        result->m5 = 2 / tanAngleHeight;
-        result->m9 = (tanAngleUp + tanAngleDown) / tanAngleHeight;
-        result->m13 = 0;
+    rlxrReserveLocate(rlxr.locateCount + 1);
+    rlxr.locateSpaces[rlxr.locateCount] = rlxr.viewSpace;
 
-        result->m2 = 0;
-        result->m6 = 0;
-        result->m10 = -(farZ + offsetZ) / (farZ - nearZ);
-        result->m14 = -(farZ * (nearZ + offsetZ)) / (farZ - nearZ);
+    rlxrLocateSpaces(rlxr.locateSpaces, rlxr.locateCount + 1, rlxr.frameState.predictedDisplayTime, rlxr.locateResults, rlxr.locateVelocities);
 
-        result->m3 = 0;
-        result->m7 = 0;
-        result->m11 = -1;
-        result->m15 = 0;
+    for (unsigned int i = 0; i < rlxr.locateCount; i++)
+    {
+        rlxr.locateTargets[i]->locationFlags = rlxr.locateResults[i].locationFlags;
+        rlxr.locateTargets[i]->pose = rlxr.locateResults[i].pose;
+        rlxr.locateTargets[i]->velocityFlags = rlxr.locateVelocities[i].velocityFlags;
+        rlxr.locateTargets[i]->linearVelocity = rlxr.locateVelocities[i].linearVelocity;
+        rlxr.locateTargets[i]->angularVelocity = rlxr.locateVelocities[i].angularVelocity;
     }
-}
-
-int BeginXrMode() {
-    assert(!rlxr.frameActive);
 
-    if (!rlxrIsSessionRunning()) return 0; // session not yet synchronized, skip this frame
+    rlxr.viewLocation = rlxr.locateResults[rlxr.locateCount];
+    rlxr.viewVelocity = rlxr.locateVelocities[rlxr.locateCount];
+    rlxr.viewLocationTime = rlxr.frameState.predictedDisplayTime;
+}
 
-    // locate view poses
+static void rlxrRebuildFilters() {
+    // lays out the state of all filtered pose samples as flat channel arrays, grouped by filter
 
-    XrViewState viewState = {XR_TYPE_VIEW_STATE};
-    XrViewLocateInfo locateInfo = {XR_TYPE_VIEW_LOCATE_INFO};
-    locateInfo.viewConfigurationType = rlxr.viewConfig;
-    locateInfo.displayTime = rlxr.frameState.predictedDisplayTime;
-    locateInfo.space = rlxr.referenceSpace;
+    rlxrFilterBank *bank = &rlxr.filters;
 
-    XrResult res = xrLocateViews(rlxr.session, &locateInfo, &viewState, rlxr.viewCount, &rlxr.viewCount, rlxr.views);
-    if (XR_FAILED(res))
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < rlxr.actionCount; i++)
     {
-        TRACELOG(LOG_ERROR, "XR: Failed to locate views (%s)", rlxrFormatResult(res));
+        rlxrAction *ac = &rlxr.actions[i];
+        if (ac->type == RLXR_TYPE_POSE && (ac->filter == RLXR_FILTER_ONE_EURO || ac->filter == RLXR_FILTER_SPRING)) count += ac->deviceCount;
     }
 
-    // begin frame
+    bank->samples = (unsigned int *)RL_REALLOC(bank->samples, count * sizeof(unsigned int));
+    bank->primed = (bool *)RL_REALLOC(bank->primed, count * sizeof(bool));
 
-    XrFrameBeginInfo beginInfo = {XR_TYPE_FRAME_BEGIN_INFO};
+    unsigned int channels = count * RLXR_FILTER_CHANNELS;
+    bank->raw = (float *)RL_REALLOC(bank->raw, channels * sizeof(float));
+    bank->value = (float *)RL_REALLOC(bank->value, channels * sizeof(float));
+    bank->deriv = (float *)RL_REALLOC(bank->deriv, channels * sizeof(float));
+    bank->param0 = (float *)RL_REALLOC(bank->param0, channels * sizeof(float));
+    bank->param1 = (float *)RL_REALLOC(bank->param1, channels * sizeof(float));
 
-    res = xrBeginFrame(rlxr.session, &beginInfo);
-    if (XR_FAILED(res))
+    bank->sampleCount = 0;
+    bank->oneEuroChannels = 0;
+
+    for (int filter = RLXR_FILTER_ONE_EURO; filter <= RLXR_FILTER_SPRING; filter++)
     {
-        if (res == XR_ERROR_SESSION_LOST || res == XR_ERROR_INSTANCE_LOST)
+        for (unsigned int i = 0; i < rlxr.actionCount; i++)
         {
-            // in the case that the app doesn't gracefully receive a _LOSS_PENDING event, we have to
-            // make sure we _eventually_ close the XR connection, clean up and make it visible to the
-            // app (using IsXrConnected)
+            rlxrAction *ac = &rlxr.actions[i];
+            if (ac->type != RLXR_TYPE_POSE || (int)ac->filter != filter) continue;
 
-            rlxr.state = XR_SESSION_STATE_LOSS_PENDING;
+            // note: the spring is parameterized by its natural frequency (critically damped, settles in about [smoothing time])
+            float p0 = filter == RLXR_FILTER_SPRING ? 2.f / fmaxf(ac->filterParams[0], 1e-3f) : ac->filterParams[0];
+            float p1 = ac->filterParams[1];
+
+            for (unsigned int d = 0; d < ac->deviceCount; d++)
+            {
+                unsigned int s = bank->sampleCount++;
+
+                bank->samples[s] = ac->sampleOffset + d;
+                bank->primed[s] = false;
+
+                for (int c = 0; c < RLXR_FILTER_CHANNELS; c++)
+                {
+                    bank->param0[s * RLXR_FILTER_CHANNELS + c] = p0;
+                    bank->param1[s * RLXR_FILTER_CHANNELS + c] = p1;
+                }
+            }
         }
 
-        TRACELOG(LOG_ERROR, "XR: Failed to begin a frame (%s)", rlxrFormatResult(res));
-        return 0;
+        if (filter == RLXR_FILTER_ONE_EURO) bank->oneEuroChannels = bank->sampleCount * RLXR_FILTER_CHANNELS;
     }
 
-    rlxr.frameActive = true;
-    rlxr.viewActiveIndex = ~0;
+    bank->channelCount = channels;
+    bank->dirty = false;
+}
 
-    if (!rlxr.frameState.shouldRender) return 0; // runtime requested to not render anything, skip views for this frame
+static float rlxrApplyDeadzone(float value, float deadzone) {
+    float magnitude = fabsf(value);
+    if (magnitude <= deadzone) return 0.f;
 
-    return rlxr.viewCount;
+    return copysignf((magnitude - deadzone) / (1.f - deadzone), value);
 }
 
-void EndXrMode() {
-    if (!rlxr.frameActive) return;
-    assert(rlxr.viewActiveIndex == ~0);
+static void rlxrApplyActionFilters() {
+    // filters the action snapshot, deadzones are applied per sample, pose filters in one pass over all filtered channels
 
-    // end frame and submit layer(s)
+    rlxrFilterBank *bank = &rlxr.filters;
 
-    XrCompositionLayerProjection layer = {XR_TYPE_COMPOSITION_LAYER_PROJECTION};
-    layer.layerFlags = 0;
-    layer.space = rlxr.referenceSpace;
-    layer.viewCount = rlxr.viewCount;
-    layer.views = rlxr.projectionViews;
+    for (unsigned int i = 0; i < rlxr.actionCount; i++)
+    {
+        rlxrAction *ac = &rlxr.actions[i];
+        if (ac->filter != RLXR_FILTER_DEADZONE) continue;
 
-    const XrCompositionLayerBaseHeader *submit_layers[1] = {(XrCompositionLayerBaseHeader *)&layer};
+        float deadzone = ac->filterParams[0];
 
-    XrFrameEndInfo endInfo = {XR_TYPE_FRAME_END_INFO};
-    endInfo.displayTime = rlxr.frameState.predictedDisplayTime;
-    endInfo.layerCount = rlxr.frameState.shouldRender ? 1 : 0;
-    endInfo.layers = submit_layers;
-    endInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE; // TODO: add support for env blend modes
+        for (unsigned int d = 0; d < ac->deviceCount; d++)
+        {
+            rlxrActionSample *sample = &rlxr.actionSamples[ac->sampleOffset + d];
 
-    XrResult res = xrEndFrame(rlxr.session, &endInfo);
-    if (XR_FAILED(res))
-    {
-        TRACELOG(LOG_ERROR, "XR: Failed to end a frame (%s)", rlxrFormatResult(res));
-    }
+            if (ac->type == RLXR_TYPE_FLOAT) sample->value.f = rlxrApplyDeadzone(sample->value.f, deadzone);
 
-    rlxr.frameActive = false;
-}
+            if (ac->type == RLXR_TYPE_VECTOR2F)
+            {
+                // radial, keeps the direction of the stick
+                float length = Vector2Length(sample->value.v);
+                sample->value.v = length > deadzone ? Vector2Scale(sample->value.v, rlxrApplyDeadzone(length, deadzone) / length) : (Vector2){0.f, 0.f};
+            }
+        }
+    }
 
-void BeginView(unsigned int index) {
-    assert(rlxr.frameActive && rlxr.viewActiveIndex == ~0);
-    assert(index < rlxr.viewCount);
+    if (bank->dirty) rlxrRebuildFilters();
+    if (bank->sampleCount == 0) return;
 
-    // acquire swapchain images
+    XrTime now = rlxr.frameState.predictedDisplayTime;
+    float dt = bank->lastTime != 0 ? (float)((now - bank->lastTime) / 1e9) : 0.f;
+    dt = Clamp(dt, 1e-4f, 0.1f); // (a long pause shouldn't make the filters jump)
 
-    rlxrViewBuffers *view = &rlxr.viewBufs[index];
+    bank->lastTime = now;
 
-    XrSwapchainImageAcquireInfo acqInfo = {XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO};
-    uint32_t colorAcquiredIndex, depthAcquiredIndex;
+    // gather valid poses into the channels, holding lost samples at their last filtered value
 
-    XrResult res = xrAcquireSwapchainImage(view->colorSwapchain, &acqInfo, &colorAcquiredIndex);
-    if (XR_FAILED(res))
+    for (unsigned int s = 0; s < bank->sampleCount; s++)
     {
-        TRACELOG(LOG_ERROR, "XR: Failed to acquire an image from swapchain (%s)", rlxrFormatResult(res));
-    }
+        const rlxrActionSample *sample = &rlxr.actionSamples[bank->samples[s]];
 
-    if (rlxr.depthSupported)
-    {
-        res = xrAcquireSwapchainImage(view->depthSwapchain, &acqInfo, &depthAcquiredIndex);
-        if (XR_FAILED(res))
+        float *raw = &bank->raw[s * RLXR_FILTER_CHANNELS];
+        float *value = &bank->value[s * RLXR_FILTER_CHANNELS];
+
+        bool valid = sample->active && (sample->locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) && (sample->locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT);
+        if (!valid)
         {
-            TRACELOG(LOG_ERROR, "XR: Failed to acquire an image from swapchain (%s)", rlxrFormatResult(res));
+            memcpy(raw, value, RLXR_FILTER_CHANNELS * sizeof(float));
+            bank->primed[s] = false;
+            continue;
+        }
+
+        XrPosef pose = sample->pose;
+
+        // keep the orientation in the hemisphere of the filtered one, q and -q are the same rotation
+        float dot = pose.orientation.x * value[3] + pose.orientation.y * value[4] + pose.orientation.z * value[5] + pose.orientation.w * value[6];
+        float sign = bank->primed[s] && dot < 0.f ? -1.f : 1.f;
+
+        raw[0] = pose.position.x;
+        raw[1] = pose.position.y;
+        raw[2] = pose.position.z;
+        raw[3] = pose.orientation.x * sign;
+        raw[4] = pose.orientation.y * sign;
+        raw[5] = pose.orientation.z * sign;
+        raw[6] = pose.orientation.w * sign;
+
+        if (!bank->primed[s])
+        {
+            memcpy(value, raw, RLXR_FILTER_CHANNELS * sizeof(float));
+            memset(&bank->deriv[s * RLXR_FILTER_CHANNELS], 0, RLXR_FILTER_CHANNELS * sizeof(float));
+            bank->primed[s] = true;
         }
     }
 
-    XrSwapchainImageWaitInfo waitInfo = {XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO};
-    waitInfo.timeout = 1000;
+    // filter all channels (branch-free loops over flat arrays, vectorized by the compiler)
 
-    // FIXME: better handle timeouts
+    float *raw = bank->raw;
+    float *value = bank->value;
+    float *deriv = bank->deriv;
+    const float *param0 = bank->param0;
+    const float *param1 = bank->param1;
 
-    do
-    {
-        res = xrWaitSwapchainImage(view->colorSwapchain, &waitInfo);
-    } while (res == XR_TIMEOUT_EXPIRED);
+    float derivAlpha = 1.f / (1.f + 1.f / (2.f * PI * 1.f * dt)); // (1 Hz derivative cutoff)
 
-    if (XR_FAILED(res))
+    for (unsigned int i = 0; i < bank->oneEuroChannels; i++)
     {
-        TRACELOG(LOG_ERROR, "XR: Failed to wait for an image from swapchain (%s)", rlxrFormatResult(res));
+        deriv[i] += derivAlpha * ((raw[i] - value[i]) / dt - deriv[i]);
+
+        float cutoff = param0[i] + param1[i] * fabsf(deriv[i]);
+        float alpha = 1.f / (1.f + 1.f / (2.f * PI * cutoff * dt));
+
+        value[i] += alpha * (raw[i] - value[i]);
     }
 
-    if (rlxr.depthSupported)
+    for (unsigned int i = bank->oneEuroChannels; i < bank->channelCount; i++)
     {
-        do
-        {
-            res = xrWaitSwapchainImage(view->depthSwapchain, &waitInfo);
-        } while (res == XR_TIMEOUT_EXPIRED);
+        float x = param0[i] * dt;
+        float decay = 1.f / (1.f + x + 0.48f * x * x + 0.235f * x * x * x);
 
-        if (XR_FAILED(res))
-        {
-            TRACELOG(LOG_ERROR, "XR: Failed to wait for an image from swapchain (%s)", rlxrFormatResult(res));
-        }
+        float change = value[i] - raw[i];
+        float temp = (deriv[i] + param0[i] * change) * dt;
+
+        deriv[i] = (deriv[i] - param0[i] * temp) * decay;
+        value[i] = raw[i] + (change + temp) * decay;
     }
 
-    // setup viewport and rlgl (very similar setup to BeginMode3D)
+    // scatter the filtered poses back into the snapshot
 
-    rlDrawRenderBatchActive();
+    for (unsigned int s = 0; s < bank->sampleCount; s++)
+    {
+        if (!bank->primed[s]) continue;
 
-    rlxr.projectionViews[index].pose = rlxr.views[index].pose;
-    rlxr.projectionViews[index].fov = rlxr.views[index].fov;
+        rlxrActionSample *sample = &rlxr.actionSamples[bank->samples[s]];
+        const float *filtered = &value[s * RLXR_FILTER_CHANNELS];
 
-    if (rlxr.depthSupported)
-    {
-        rlxr.depthInfoViews[index].nearZ = rlGetCullDistanceNear();
-        rlxr.depthInfoViews[index].farZ = rlGetCullDistanceFar();
+        Quaternion orientation = QuaternionNormalize((Quaternion){filtered[3], filtered[4], filtered[5], filtered[6]});
+
+        sample->pose.position = (XrVector3f){filtered[0], filtered[1], filtered[2]};
+        sample->pose.orientation = (XrQuaternionf){orientation.x, orientation.y, orientation.z, orientation.w};
     }
+}
 
-    int w = rlxr.viewProps[index].recommendedImageRectWidth;
-    int h = rlxr.viewProps[index].recommendedImageRectHeight;
+static void rlxrPublishSnapshot() {
+    // copies the action snapshot into a buffer no reader holds and makes it the latest, never waits on readers
 
-    rlViewport(0, 0, w, h);
-    rlScissor(0, 0, w, h);
+    long latest = RLXR_ATOMIC_LOAD(&rlxr.latestSnapshot) - 1;
 
-    rlFramebufferAttach(view->framebuffer, view->colorImages[colorAcquiredIndex].image, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
-    if (rlxr.depthSupported)
+    int index = -1;
+    for (int i = 0; i < RLXR_SNAPSHOT_BUFFERS && index < 0; i++)
     {
-        // attach XrSwapchain depth if supported, if not a render buffer is already attached from swapchain setup
-        rlFramebufferAttach(view->framebuffer, view->depthImages[depthAcquiredIndex].image, RL_ATTACHMENT_DEPTH, RL_ATTACHMENT_TEXTURE2D, 0);
+        // note: a reader may still grab a stale index here, it sees latestSnapshot change and retries
+        if (i != latest && RLXR_ATOMIC_LOAD(&rlxr.snapshots[i].refs) == 0) index = i;
     }
 
-    rlEnableFramebuffer(view->framebuffer);
-    rlSetFramebufferWidth(w);
-    rlSetFramebufferHeight(h);
-
-    rlEnableDepthTest();
+    if (index < 0) return; // (all other buffers held by readers, keep the previous snapshot published)
 
-    // setup view camera
+    rlInputSnapshot *snapshot = &rlxr.snapshots[index];
 
-    Matrix xr_proj;
-    XrMatrix4x4f_CreateProjectionFov(&xr_proj, GRAPHICS_OPENGL, rlxr.views[index].fov, rlGetCullDistanceNear(), rlGetCullDistanceFar());
-    rlSetMatrixProjection(xr_proj);
+    if (snapshot->sampleCount != rlxr.sampleCount)
+    {
+        snapshot->samples = (rlxrActionSample *)RL_REALLOC(snapshot->samples, rlxr.sampleCount * sizeof(rlxrActionSample));
+        snapshot->sampleCount = rlxr.sampleCount;
+    }
 
-    Vector3 pos = Vector3Add(rlxr.refPosition, (Vector3){rlxr.views[index].pose.position.x, rlxr.views[index].pose.position.y, rlxr.views[index].pose.position.z});
-    Quaternion quat = QuaternionMultiply(rlxr.refOrientation, (Quaternion){rlxr.views[index].pose.orientation.x, rlxr.views[index].pose.orientation.y, rlxr.views[index].pose.orientation.z, rlxr.views[index].pose.orientation.w});
+    memcpy(snapshot->samples, rlxr.actionSamples, rlxr.sampleCount * sizeof(rlxrActionSample));
 
-    Matrix xr_view = MatrixMultiply(QuaternionToMatrix(quat), MatrixTranslate(pos.x, pos.y, pos.z));
-    xr_view = MatrixInvert(xr_view);
-    rlSetMatrixModelview(xr_view);
+    snapshot->time = rlxr.frameState.predictedDisplayTime;
+    snapshot->refPosition = rlxr.offsetPosition;
+    snapshot->refOrientation = rlxr.offsetOrientation;
+    snapshot->viewLocation = rlxr.viewLocation;
 
-    rlxr.viewActiveIndex = index;
+    RLXR_ATOMIC_STORE(&rlxr.latestSnapshot, index + 1);
 }
 
-void EndView() {
-    assert(rlxr.frameActive && rlxr.viewActiveIndex != ~0);
+static const rlxrActionSample *rlxrGetActionSample(unsigned int action, rlActionDevices device, rlxrActionSample *scratch) {
+    // returns the current frame sample of an action, either from the snapshot or fetched directly into [scratch]
 
-    rlDrawRenderBatchActive();
+    int slot = rlxrDeviceSlot(device);
+    if (slot < 0)
+    {
+        TRACELOG(LOG_WARNING, "XR: Unsupported device in action fetch (action: %d)", action);
+        return NULL;
+    }
+
+    int index = rlxrActionDeviceIndex(&rlxr.actions[action], slot);
+    if (index < 0) return NULL; // (action not loaded for this device)
+
+#ifndef RLXR_DIRECT_ACTION_QUERIES
+    (void)scratch;
+    return &rlxr.actionSamples[rlxr.actions[action].sampleOffset + index];
+#else
+    rlxrSampleAction(action, slot, rlxr.frameState.predictedDisplayTime, scratch);
+    return scratch;
+#endif
+}
 
-    // release swapchains
+static void rlxrUpdateHandJoints() {
+    // locates all joints of both hands at the predicted display time and stores them with the reference offset applied
 
-    XrSwapchainImageReleaseInfo relInfo = {XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO};
+    XrHandJointLocationEXT locations[RLXR_HAND_JOINT_COUNT];
+    XrHandJointVelocityEXT velocities[RLXR_HAND_JOINT_COUNT];
 
-    XrResult res = xrReleaseSwapchainImage(rlxr.viewBufs[rlxr.viewActiveIndex].colorSwapchain, &relInfo);
-    if (XR_FAILED(res))
+    for (int hand = 0; hand < 2; hand++)
+    {
+        rlHandJoints *joints = &rlxr.handJoints[hand];
+
+        XrHandJointVelocitiesEXT jointVelocities = {XR_TYPE_HAND_JOINT_VELOCITIES_EXT};
+        jointVelocities.jointCount = RLXR_HAND_JOINT_COUNT;
+        jointVelocities.jointVelocities = velocities;
+
+        XrHandJointLocationsEXT jointLocations = {XR_TYPE_HAND_JOINT_LOCATIONS_EXT};
+        jointLocations.next = &jointVelocities;
+        jointLocations.jointCount = RLXR_HAND_JOINT_COUNT;
+        jointLocations.jointLocations = locations;
+
+        XrHandJointsLocateInfoEXT locateInfo = {XR_TYPE_HAND_JOINTS_LOCATE_INFO_EXT};
+        locateInfo.baseSpace = rlxr.referenceSpace;
+        locateInfo.time = rlxr.frameState.predictedDisplayTime;
+
+        XrResult res = rlxr.pfn.LocateHandJointsEXT(rlxr.handTrackers[hand], &locateInfo, &jointLocations);
+        if (XR_FAILED(res) || !jointLocations.isActive)
+        {
+            if (XR_FAILED(res)) TRACELOG(LOG_ERROR, "XR: Failed to locate hand joints (%s)", rlxrFormatResult(res));
+
+            memset(joints, 0, sizeof(rlHandJoints));
+            continue;
+        }
+
+        joints->active = true;
+        joints->validJoints = 0;
+        joints->validLinearVelocities = 0;
+        joints->validAngularVelocities = 0;
+
+        // de-interleave into SoA
+
+        for (int i = 0; i < RLXR_HAND_JOINT_COUNT; i++)
+        {
+            const XrHandJointLocationEXT *loc = &locations[i];
+
+            if ((loc->locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) && (loc->locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)) joints->validJoints |= 1u << i;
+
+            joints->positions[i * 3 + 0] = loc->pose.position.x;
+            joints->positions[i * 3 + 1] = loc->pose.position.y;
+            joints->positions[i * 3 + 2] = loc->pose.position.z;
+
+            joints->orientations[i * 4 + 0] = loc->pose.orientation.x;
+            joints->orientations[i * 4 + 1] = loc->pose.orientation.y;
+            joints->orientations[i * 4 + 2] = loc->pose.orientation.z;
+            joints->orientations[i * 4 + 3] = loc->pose.orientation.w;
+
+            joints->radii[i] = loc->radius;
+
+            // (invalid velocities are undefined, zeroed so the offset loops below stay branchless)
+            const XrVector3f zero = {0.f, 0.f, 0.f};
+            bool linearValid = velocities[i].velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
+            bool angularValid = velocities[i].velocityFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
+
+            if (linearValid) joints->validLinearVelocities |= 1u << i;
+            if (angularValid) joints->validAngularVelocities |= 1u << i;
+
+            memcpy(&joints->linearVelocities[i * 3], linearValid ? &velocities[i].linearVelocity : &zero, sizeof(float) * 3);
+            memcpy(&joints->angularVelocities[i * 3], angularValid ? &velocities[i].angularVelocity : &zero, sizeof(float) * 3);
+        }
+
+        // apply the reference offset (same as xrPoseToRlPose), kept as flat loops over the arrays so they can be vectorized
+
+        const Quaternion q = rlxr.offsetOrientation;
+        const Matrix r = QuaternionToMatrix(q);
+        const Vector3 t = rlxr.offsetPosition;
+
+        for (int i = 0; i < RLXR_HAND_JOINT_COUNT; i++)
+        {
+            float *p = &joints->positions[i * 3];
+            float *lv = &joints->linearVelocities[i * 3];
+            float *av = &joints->angularVelocities[i * 3];
+            float px = p[0], py = p[1], pz = p[2];
+            float lx = lv[0], ly = lv[1], lz = lv[2];
+            float ax = av[0], ay = av[1], az = av[2];
+
+            p[0] = r.m0 * px + r.m4 * py + r.m8 * pz + t.x;
+            p[1] = r.m1 * px + r.m5 * py + r.m9 * pz + t.y;
+            p[2] = r.m2 * px + r.m6 * py + r.m10 * pz + t.z;
+
+            lv[0] = r.m0 * lx + r.m4 * ly + r.m8 * lz;
+            lv[1] = r.m1 * lx + r.m5 * ly + r.m9 * lz;
+            lv[2] = r.m2 * lx + r.m6 * ly + r.m10 * lz;
+
+            av[0] = r.m0 * ax + r.m4 * ay + r.m8 * az;
+            av[1] = r.m1 * ax + r.m5 * ay + r.m9 * az;
+            av[2] = r.m2 * ax + r.m6 * ay + r.m10 * az;
+        }
+
+        for (int i = 0; i < RLXR_HAND_JOINT_COUNT; i++)
+        {
+            float *o = &joints->orientations[i * 4];
+            float x = o[0], y = o[1], z = o[2], w = o[3];
+
+            o[0] = q.x * w + q.w * x + q.y * z - q.z * y;
+            o[1] = q.y * w + q.w * y + q.z * x - q.x * z;
+            o[2] = q.z * w + q.w * z + q.x * y - q.y * x;
+            o[3] = q.w * w - q.x * x - q.y * y - q.z * z;
+        }
+    }
+}
+
+static void rlxrSampleHaptics(const rlxrHapticTarget *target, XrTime time, float *pcm, float *envelope) {
+    // merges all effects playing on a target at [time], effects are linearly interpolated and summed per kind
+    // (PCM waveforms into [pcm], amplitude envelopes into [envelope])
+
+    float sums[2] = {0.f, 0.f};
+
+    for (unsigned int i = 0; i < rlxr.hapticEffectCount; i++)
     {
-        TRACELOG(LOG_ERROR, "XR: Failed to release a swapchain image (%s)", rlxrFormatResult(res));
+        const rlxrHapticEffect *effect = &rlxr.hapticEffects[i];
+        if (effect->action != target->action || effect->slot != target->slot || time < effect->start) continue;
+
+        double pos = (double)(time - effect->start) / effect->interval;
+        unsigned int idx = (unsigned int)pos;
+
+        if (idx + 1 < effect->count)
+        {
+            float frac = (float)(pos - idx);
+            sums[effect->pcm] += effect->samples[idx] + (effect->samples[idx + 1] - effect->samples[idx]) * frac;
+        } else if (idx + 1 == effect->count)
+        {
+            sums[effect->pcm] += effect->samples[idx];
+        }
     }
 
-    if (rlxr.depthSupported)
+    *pcm = Clamp(sums[1], -1.f, 1.f);
+    *envelope = Clamp(sums[0], 0.f, 1.f);
+}
+
+static float rlxrSampleHapticsPcm(const rlxrHapticTarget *target, XrTime time) {
+    // PCM devices play envelopes as a modulated carrier, mixed with the PCM effects
+
+    float pcm, envelope;
+    rlxrSampleHaptics(target, time, &pcm, &envelope);
+
+    if (envelope > 0.f)
     {
-        res = xrReleaseSwapchainImage(rlxr.viewBufs[rlxr.viewActiveIndex].depthSwapchain, &relInfo);
+        double phase = fmod((double)time * RLXR_HAPTIC_CARRIER_FREQUENCY / 1e9, 1.0);
+        pcm += envelope * (float)sin(2.0 * PI * phase);
+    }
+
+    return Clamp(pcm, -1.f, 1.f);
+}
+
+static float rlxrSampleHapticsAmplitude(const rlxrHapticTarget *target, XrTime time) {
+    // amplitude-only devices play envelopes directly, PCM effects by their magnitude
+
+    float pcm, envelope;
+    rlxrSampleHaptics(target, time, &pcm, &envelope);
+
+    return Clamp(envelope + fabsf(pcm), 0.f, 1.f);
+}
+
+static void rlxrUpdateHaptics() {
+    // sends the merged haptic effects of all targets to the runtime, should be called once per frame after xrWaitFrame
+
+    XrTime now = rlxr.frameState.predictedDisplayTime;
+    XrTime period = rlxr.frameState.predictedDisplayPeriod;
+
+    // drop finished effects
+
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < rlxr.hapticEffectCount; i++)
+    {
+        rlxrHapticEffect *effect = &rlxr.hapticEffects[i];
+
+        if (effect->start + (XrTime)(effect->interval * effect->count) <= now)
+        {
+            RL_FREE(effect->samples);
+            continue;
+        }
+
+        rlxr.hapticEffects[kept++] = *effect;
+    }
+
+    rlxr.hapticEffectCount = kept;
+
+    // drive all targets with playing effects
+
+    kept = 0;
+    for (unsigned int i = 0; i < rlxr.hapticTargetCount; i++)
+    {
+        rlxrHapticTarget target = rlxr.hapticTargets[i];
+
+        bool playing = false;
+        for (unsigned int j = 0; j < rlxr.hapticEffectCount && !playing; j++)
+        {
+            playing = rlxr.hapticEffects[j].action == target.action && rlxr.hapticEffects[j].slot == target.slot;
+        }
+
+        if (!playing) continue;
+
+        XrHapticActionInfo hapticInfo = {XR_TYPE_HAPTIC_ACTION_INFO};
+        hapticInfo.action = rlxr.actions[target.action].action;
+        hapticInfo.subactionPath = rlxr.userPaths[target.slot];
+
+        XrResult res = XR_SUCCESS;
+
+        if (target.sampleRate > 0.f)
+        {
+            // stream the merged waveform, keeping two frames queued in the runtime
+
+            XrTime from = target.queuedUntil > now ? target.queuedUntil : now;
+            XrTime to = now + 2 * period;
+
+            uint32_t sampleCount = to > from ? (uint32_t)((to - from) * (double)target.sampleRate / 1e9) : 0;
+            if (sampleCount > XR_MAX_HAPTIC_PCM_BUFFER_SIZE_FB) sampleCount = XR_MAX_HAPTIC_PCM_BUFFER_SIZE_FB;
+
+            if (sampleCount != 0)
+            {
+                double sampleInterval = 1e9 / target.sampleRate;
+                for (uint32_t s = 0; s < sampleCount; s++) rlxr.hapticBuffer[s] = rlxrSampleHapticsPcm(&target, from + (XrTime)(s * sampleInterval));
+
+                uint32_t consumed = 0;
+
+                XrHapticPcmVibrationFB pcm = {XR_TYPE_HAPTIC_PCM_VIBRATION_FB};
+                pcm.bufferSize = sampleCount;
+                pcm.buffer = rlxr.hapticBuffer;
+                pcm.sampleRate = target.sampleRate;
+                pcm.append = XR_TRUE;
+                pcm.samplesConsumed = &consumed;
+
+                res = xrApplyHapticFeedback(rlxr.session, &hapticInfo, (XrHapticBaseHeader *)&pcm);
+                if (XR_SUCCEEDED(res)) target.queuedUntil = from + (XrTime)(consumed * sampleInterval);
+            }
+        } else
+        {
+            // no PCM, one pulse per frame with the mean amplitude over the frame (slightly longer than a frame, cut off by the next pulse)
+
+            float amplitude = 0.f;
+            for (int s = 0; s < 8; s++) amplitude += rlxrSampleHapticsAmplitude(&target, now + period * s / 8);
+
+            XrHapticVibration vibration = {XR_TYPE_HAPTIC_VIBRATION};
+            vibration.amplitude = amplitude / 8.f;
+            vibration.duration = period + period / 2;
+            vibration.frequency = XR_FREQUENCY_UNSPECIFIED;
+
+            res = xrApplyHapticFeedback(rlxr.session, &hapticInfo, (XrHapticBaseHeader *)&vibration);
+        }
+
         if (XR_FAILED(res))
         {
-            TRACELOG(LOG_ERROR, "XR: Failed to release a swapchain image (%s)", rlxrFormatResult(res));
+            TRACELOG(LOG_ERROR, "XR: Failed to apply haptic effects (action: %d; result: %s)", target.action, rlxrFormatResult(res));
         }
+
+        rlxr.hapticTargets[kept++] = target;
     }
 
-    // return rlgl to a default state
+    rlxr.hapticTargetCount = kept;
+}
 
-    rlMatrixMode(RL_PROJECTION);
-    rlPopMatrix();
+static void rlxrRunJobs() {
+    if (rlxr.jobCount == 0 || rlxr.frameWakeTime == 0) return;
 
-    rlMatrixMode(RL_MODELVIEW);
-    rlLoadIdentity();
+    // note: xrWaitFrame throttles the app to the display period, so the next call is expected to return
+    //       one period after the last one. Everything between now and then is idle time we can use.
 
-    rlDisableFramebuffer();
-    rlDisableDepthTest();
+    int64_t deadline = rlxr.frameWakeTime + rlxr.frameState.predictedDisplayPeriod - RLXR_JOB_SAFETY_MARGIN;
+    int64_t now = rlxrGetMonotonicTime();
 
-#ifndef RLXR_STANDALONE
-    // a hacky way to tell raylib to restore its default window viewport
-    EndTextureMode();
-#endif
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < rlxr.jobCount; i++)
+    {
+        rlxrJob job = rlxr.jobs[i];
+
+        if (job.budget > rlxr.frameState.predictedDisplayPeriod - RLXR_JOB_SAFETY_MARGIN)
+        {
+            // can never fit (only possible for jobs enqueued before the first frame, when the period was unknown)
+            TRACELOG(LOG_WARNING, "XR: Job budget (%ld ns) exceeds the frame period, job dropped", job.budget);
+            continue;
+        }
+
+        if (now + job.budget > deadline)
+        {
+            // doesn't fit in the remaining time, keep for the next frame (preserving order)
+            rlxr.jobs[kept++] = job;
+            continue;
+        }
+
+        job.func(job.userData);
+        now = rlxrGetMonotonicTime();
+    }
+
+    rlxr.jobCount = kept;
+}
+
+static void submitSuggestedBindings() {
+    assert(!rlxr.actionSetAttached);
+
+    XrActionSuggestedBinding *profileBindings = (XrActionSuggestedBinding *)RL_MALLOC(rlxr.bindingCount * sizeof(XrActionSuggestedBinding));
+
+    for (unsigned int i = 0; i < rlxr.bindingCount; i++)
+    {
+        XrPath profile = rlxr.bindings[i].profile;
+        if (profile == XR_NULL_PATH) continue; // (already submitted)
+
+        // gather all bindings of this profile
+
+        unsigned int profileBindingCount = 0;
+        for (unsigned int j = i; j < rlxr.bindingCount; j++)
+        {
+            if (rlxr.bindings[j].profile != profile) continue;
+
+            profileBindings[profileBindingCount++] = rlxr.bindings[j].binding;
+            rlxr.bindings[j].profile = XR_NULL_PATH;
+        }
+
+        TRACELOGD("XR: Suggesting %d bindings for %s", profileBindingCount, rlxrPathString(profile));
+
+        XrInteractionProfileSuggestedBinding profileInfo = {XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+        profileInfo.interactionProfile = profile;
+        profileInfo.countSuggestedBindings = profileBindingCount;
+        profileInfo.suggestedBindings = profileBindings;
+
+        XrResult res = xrSuggestInteractionProfileBindings(rlxr.instance, &profileInfo);
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_ERROR, "XR: Failed to suggest bindings, input will probably not work (%s)", rlxrFormatResult(res));
+        }
+    }
+
+    RL_FREE(profileBindings);
+    rlxr.bindingCount = 0;
+}
+
+static void rlxrWriteChunk(uint32_t tag, const void *data, uint32_t size) {
+    // appends a tagged chunk to the recording (readers skip unknown tags)
+
+    uint32_t chunk[2] = {tag, size};
+    fwrite(chunk, sizeof(chunk), 1, rlxr.recording.file);
+    if (size != 0) fwrite(data, size, 1, rlxr.recording.file);
+}
+
+static void rlxrRecordSessionState(XrSessionState state, XrTime time) {
+    rlxrEventRecord event = {(int32_t)state, time};
+    rlxrWriteChunk(RLXR_CHUNK_EVENT, &event, sizeof(event));
+}
+
+static void rlxrRecordFrame() {
+    // records the frame state and the action snapshot of this frame, should be called after the snapshot update
+
+    rlxrFrameRecord frame = {0};
+    frame.predictedDisplayTime = rlxr.frameState.predictedDisplayTime;
+    frame.predictedDisplayPeriod = rlxr.frameState.predictedDisplayPeriod;
+    frame.shouldRender = rlxr.frameState.shouldRender;
+
+    frame.viewLocationFlags = rlxr.viewLocation.locationFlags;
+    frame.viewPose = rlxr.viewLocation.pose;
+    frame.viewVelocityFlags = rlxr.viewVelocity.velocityFlags;
+    frame.viewLinearVelocity = rlxr.viewVelocity.linearVelocity;
+    frame.viewAngularVelocity = rlxr.viewVelocity.angularVelocity;
+
+    rlxrWriteChunk(RLXR_CHUNK_FRAME, &frame, sizeof(frame));
+    rlxrWriteChunk(RLXR_CHUNK_ACTIONS, rlxr.actionSamples, rlxr.sampleCount * sizeof(rlxrActionSample));
+
+    rlxr.recording.frameCount++;
+}
+
+static void rlxrRecordViews() {
+    rlxrViewRecord *views = (rlxrViewRecord *)RL_MALLOC(rlxr.viewCount * sizeof(rlxrViewRecord));
+
+    for (unsigned int i = 0; i < rlxr.viewCount; i++)
+    {
+        views[i].pose = rlxr.views[i].pose;
+        views[i].fov = rlxr.views[i].fov;
+    }
+
+    rlxrWriteChunk(RLXR_CHUNK_VIEWS, views, rlxr.viewCount * sizeof(rlxrViewRecord));
+    RL_FREE(views);
+}
+
+static bool rlxrReadChunk(uint32_t *tag, uint32_t *size) {
+    // reads the next replay chunk into the replay buffer, returns false at the end of the recording
+
+    uint32_t chunk[2];
+    if (fread(chunk, sizeof(chunk), 1, rlxr.replay.file) != 1) return false;
+
+    if (chunk[1] > rlxr.replay.bufferSize)
+    {
+        rlxr.replay.buffer = RL_REALLOC(rlxr.replay.buffer, chunk[1]);
+        rlxr.replay.bufferSize = chunk[1];
+    }
+
+    if (chunk[1] != 0 && fread(rlxr.replay.buffer, chunk[1], 1, rlxr.replay.file) != 1) return false;
+
+    *tag = chunk[0];
+    *size = chunk[1];
+    return true;
+}
+
+static void rlxrReplayViews(uint32_t size) {
+    if (size != rlxr.viewCount * sizeof(rlxrViewRecord)) return;
+
+    const rlxrViewRecord *views = (const rlxrViewRecord *)rlxr.replay.buffer;
+    for (unsigned int i = 0; i < rlxr.viewCount; i++)
+    {
+        rlxr.views[i].pose = views[i].pose;
+        rlxr.views[i].fov = views[i].fov;
+    }
+}
+
+static void rlxrReplayActionSamples(const rlxrActionSample *samples) {
+    // replaces the snapshot with recorded samples, queueing input events the same way as rlxrUpdateActionSamples
+
+    for (unsigned int i = 0; i < rlxr.actionCount; i++)
+    {
+        rlxrAction *ac = &rlxr.actions[i];
+        unsigned int deviceIndex = 0;
+
+        for (int slot = 0; slot < RLXR_DEVICE_COUNT; slot++)
+        {
+            if (!(ac->subpaths & (1 << slot))) continue;
+
+            rlxrActionSample *sample = &rlxr.actionSamples[ac->sampleOffset + deviceIndex];
+            rlInputValue *rawValue = &rlxr.rawValues[ac->sampleOffset + deviceIndex];
+
+            *sample = samples[ac->sampleOffset + deviceIndex++];
+
+            if (sample->changed && ac->type != RLXR_TYPE_POSE) rlxrPushInputEvent(i, slot, rawValue, sample);
+            memcpy(rawValue, &sample->value, sizeof(rlInputValue));
+        }
+    }
+}
+
+static void rlxrReplayFrame() {
+    // feeds the next recorded frame into the frame state, action snapshot and views (replaces the runtime sync of UpdateXr)
+
+    if (!rlxr.actionSetAttached)
+    {
+        // nothing to attach without a runtime, only allocate the snapshot
+
+        rlxr.bindingCount = 0;
+        rlxr.actionSetAttached = true;
+        rlxr.actionSamples = (rlxrActionSample *)RL_CALLOC(rlxr.sampleCount, sizeof(rlxrActionSample));
+        rlxr.rawValues = (rlInputValue *)RL_CALLOC(rlxr.sampleCount, sizeof(rlInputValue));
+    }
+
+    if (rlxr.state == XR_SESSION_STATE_EXITING) return;
+
+    // fill the rest of the recorded frame period with queued jobs, so replays run the same frame workload as the app
+
+    rlxrRunJobs();
+
+    uint32_t tag, size;
+    while (rlxrReadChunk(&tag, &size))
+    {
+        switch (tag)
+        {
+        case RLXR_CHUNK_EVENT:
+        {
+            if (size != sizeof(rlxrEventRecord)) break;
+            rlxrEventRecord *event = (rlxrEventRecord *)rlxr.replay.buffer;
+
+            TRACELOG(LOG_DEBUG, "XR: Replayed session state changed: %d -> %d", rlxr.state, event->state);
+            rlxr.state = (XrSessionState)event->state;
+
+            break;
+        }
+
+        case RLXR_CHUNK_FRAME:
+        {
+            if (size != sizeof(rlxrFrameRecord)) break;
+            rlxrFrameRecord *frame = (rlxrFrameRecord *)rlxr.replay.buffer;
+
+            rlxr.frameState.predictedDisplayTime = frame->predictedDisplayTime;
+            rlxr.frameState.predictedDisplayPeriod = frame->predictedDisplayPeriod;
+            rlxr.frameState.shouldRender = frame->shouldRender;
+
+            rlxr.frameWakeTime = rlxrGetMonotonicTime(); // (replays aren't throttled, the frame starts now)
+
+            rlxr.viewLocation = (XrSpaceLocation){XR_TYPE_SPACE_LOCATION};
+            rlxr.viewLocation.locationFlags = frame->viewLocationFlags;
+            rlxr.viewLocation.pose = frame->viewPose;
+
+            rlxr.viewVelocity = (XrSpaceVelocity){XR_TYPE_SPACE_VELOCITY};
+            rlxr.viewVelocity.velocityFlags = frame->viewVelocityFlags;
+            rlxr.viewVelocity.linearVelocity = frame->viewLinearVelocity;
+            rlxr.viewVelocity.angularVelocity = frame->viewAngularVelocity;
+
+            rlxr.viewLocationTime = frame->predictedDisplayTime;
+            break;
+        }
+
+        case RLXR_CHUNK_ACTIONS:
+        {
+            if (size != rlxr.sampleCount * sizeof(rlxrActionSample))
+            {
+                TRACELOG(LOG_ERROR, "XR: Replay doesn't match the loaded actions (%d recorded samples, %d loaded); rlxr disconnected.", (int)(size / sizeof(rlxrActionSample)), rlxr.sampleCount);
+
+                rlxr.state = XR_SESSION_STATE_EXITING;
+                return;
+            }
+
+            rlxrReplayActionSamples((const rlxrActionSample *)rlxr.replay.buffer);
+            rlxrApplyActionFilters();
+            rlxrPublishSnapshot();
+
+            // views located by BeginXrMode follow the snapshot of the same frame (missing if the app skipped rendering)
+
+            long next = ftell(rlxr.replay.file);
+            if (rlxrReadChunk(&tag, &size) && tag == RLXR_CHUNK_VIEWS)
+                rlxrReplayViews(size);
+            else
+                fseek(rlxr.replay.file, next, SEEK_SET);
+
+            rlxr.replay.frameCount++;
+            return;
+        }
+
+        case RLXR_CHUNK_VIEWS:
+            rlxrReplayViews(size);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    TRACELOG(LOG_INFO, "XR: Replay finished (%d frames); rlxr disconnected.", rlxr.replay.frameCount);
+    rlxr.state = XR_SESSION_STATE_EXITING;
+}
+
+static void rlxrUpdateCurrentProfiles() {
+    // refreshes the cached interaction profiles of all devices used by actions (other top level paths are not queried)
+
+    unsigned int usedDevices = 0;
+    for (unsigned int i = 0; i < rlxr.actionCount; i++) usedDevices |= rlxr.actions[i].subpaths;
+
+    for (int slot = 0; slot < RLXR_DEVICE_COUNT; slot++)
+    {
+        if (!(usedDevices & (1 << slot))) continue;
+
+        XrInteractionProfileState profileState = {XR_TYPE_INTERACTION_PROFILE_STATE};
+
+        XrResult res = xrGetCurrentInteractionProfile(rlxr.session, rlxr.userPaths[slot], &profileState);
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_WARNING, "XR: Failed to get the current interaction profile of %s (%s)", rlxrDevicePaths[slot], rlxrFormatResult(res));
+            continue;
+        }
+
+        if (profileState.interactionProfile == rlxr.currentProfiles[slot]) continue;
+
+        TRACELOG(LOG_INFO, "XR: Interaction profile of %s changed: %s", rlxrDevicePaths[slot], rlxrPathString(profileState.interactionProfile));
+
+        rlxr.currentProfiles[slot] = profileState.interactionProfile;
+        rlxr.profileChanged = true;
+    }
+}
+
+static XrReferenceSpaceType rlxrReferenceSpaceType(rlReferenceType type) {
+    switch (type)
+    {
+    case RLXR_REFERENCE_LOCAL:
+        return XR_REFERENCE_SPACE_TYPE_LOCAL;
+
+    case RLXR_REFERENCE_LOCAL_FLOOR:
+        return XR_REFERENCE_SPACE_TYPE_LOCAL_FLOOR_EXT;
+
+    default:
+        return XR_REFERENCE_SPACE_TYPE_STAGE;
+    }
+}
+
+static bool rlxrCreateReferenceSpace(rlReferenceType type, XrPosef poseInReferenceSpace) {
+    // replaces the reference space with a new one of [type], its origin offset by [poseInReferenceSpace]
+
+    XrReferenceSpaceCreateInfo refInfo = {XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+    refInfo.referenceSpaceType = rlxrReferenceSpaceType(type);
+    refInfo.poseInReferenceSpace = poseInReferenceSpace;
+
+    XrSpace newSpace;
+    XrResult res = xrCreateReferenceSpace(rlxr.session, &refInfo, &newSpace);
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_WARNING, "XR: Failed to create reference space (%s)", rlxrFormatResult(res));
+        return false;
+    }
+
+    if (rlxr.referenceSpace)
+    {
+        xrDestroySpace(rlxr.referenceSpace);
+    }
+
+    rlxr.referenceSpace = newSpace;
+    rlxr.referenceType = type;
+    rlxr.referencePose = poseInReferenceSpace;
+
+    // cached locations (including the snapshot view location) are relative to the old space
+    // note: action poses in the snapshot are only refreshed by the next UpdateXr
+
+    rlxr.locateGeneration++;
+    rlxr.viewLocationTime = 0;
+
+    return true;
+}
+
+static void rlxrApplyRecenter() {
+    // a pending reference space change takes effect in this frame
+
+    rlxr.recenterPending = false;
+
+    if (rlxr.recenterCompensation && rlxr.recenterPoseValid)
+    {
+        // keep the previous origin, the new space offset is (change)^-1 * (current offset)
+
+        XrPosef compensated = rlxrComposePose(rlxrInvertPose(rlxr.recenterPose), rlxr.referencePose);
+
+        if (rlxrCreateReferenceSpace(rlxr.referenceType, compensated))
+        {
+            TRACELOG(LOG_INFO, "XR: Reference space recentered (compensated)");
+            return;
+        }
+    }
+
+    TRACELOG(LOG_INFO, "XR: Reference space recentered");
+    rlxr.recentered = true;
+}
+
+static void rlxrBakeReferenceOffset() {
+    // recreates the reference space with the offset set since the last frame, so a frame never mixes two spaces
+
+    rlxr.bakedOffsetDirty = false;
+
+    // the new space pose is (current pose, incl. recenter compensation) * (baked offset) * (new offset)^-1
+
+    XrPosef newOffset = {{rlxr.refOrientation.x, rlxr.refOrientation.y, rlxr.refOrientation.z, rlxr.refOrientation.w}, {rlxr.refPosition.x, rlxr.refPosition.y, rlxr.refPosition.z}};
+
+    XrPosef pose = rlxrComposePose(rlxrComposePose(rlxr.referencePose, rlxr.bakedOffset), rlxrInvertPose(newOffset));
+    if (!rlxrCreateReferenceSpace(rlxr.referenceType, pose))
+    {
+        TRACELOG(LOG_WARNING, "XR: Failed to bake the reference offset");
+        return;
+    }
+
+    rlxr.bakedOffset = newOffset;
+}
+
+void UpdateXr() {
+    if (rlxr.replay.file)
+    {
+        rlxrReplayFrame();
+        return;
+    }
+
+    // attach action set (first update call)
+
+    if (!rlxr.actionSetAttached)
+    {
+        // suggest bindings
+
+        submitSuggestedBindings();
+
+        // attach all action sets (inactive and internal ones included)
+
+        unsigned int setCount = rlxr.actionSetCount;
+
+        XrActionSet *sets = (XrActionSet *)RL_MALLOC((setCount + 1) * sizeof(XrActionSet));
+        for (unsigned int i = 0; i < rlxr.actionSetCount; i++) sets[i] = rlxr.actionSets[i].actionSet;
+        if (rlxr.internalActionSet != XR_NULL_HANDLE) sets[setCount++] = rlxr.internalActionSet;
+
+        XrSessionActionSetsAttachInfo attachInfo = {XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
+        attachInfo.countActionSets = setCount;
+        attachInfo.actionSets = sets;
+
+        XrResult res = xrAttachSessionActionSets(rlxr.session, &attachInfo);
+        RL_FREE(sets);
+
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_ERROR, "XR: Failed to attach action set, input will probably not work (%s)", rlxrFormatResult(res));
+        } else if (rlxr.actionCount != 0)
+        {
+            TRACELOG(LOG_INFO, "XR: %d actions attached successfully", rlxr.actionCount);
+        }
+
+        rlxr.actionSetAttached = true;
+
+#ifndef RLXR_DIRECT_ACTION_QUERIES
+        rlxr.actionSamples = (rlxrActionSample *)RL_CALLOC(rlxr.sampleCount, sizeof(rlxrActionSample));
+        rlxr.rawValues = (rlInputValue *)RL_CALLOC(rlxr.sampleCount, sizeof(rlInputValue));
+#endif
+    }
+
+    // poll events
+
+    rlxr.profileChanged = false;
+    rlxr.recentered = false;
+
+    XrEventDataBuffer ev = {XR_TYPE_EVENT_DATA_BUFFER};
+    for (; xrPollEvent(rlxr.instance, &ev) == XR_SUCCESS; ev = (XrEventDataBuffer){XR_TYPE_EVENT_DATA_BUFFER})
+    {
+        switch (ev.type)
+        {
+        case XR_TYPE_EVENT_DATA_EVENTS_LOST:
+            TRACELOG(LOG_WARNING, "XR: Event buffer overflow, %d events lost; UpdateXr might be getting called too little", ((XrEventDataEventsLost *)&ev)->lostEventCount);
+            break;
+
+        case XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING:
+            TRACELOG(LOG_ERROR, "XR: Instance loss pending; rlxr disconnected.");
+
+            rlxr.state = XR_SESSION_STATE_LOSS_PENDING;
+            break;
+
+        case XR_TYPE_EVENT_DATA_REFERENCE_SPACE_CHANGE_PENDING:
+        {
+            XrEventDataReferenceSpaceChangePending *change = (XrEventDataReferenceSpaceChangePending *)&ev;
+            if (change->referenceSpaceType == XR_REFERENCE_SPACE_TYPE_STAGE) rlxr.playAreaValid = false; // (the bounds may have changed too)
+
+            if (change->referenceSpaceType != rlxrReferenceSpaceType(rlxr.referenceType)) break; // (not the space in use)
+
+            // note: applied once a frame reaches changeTime, locations before that are still in the previous space
+            TRACELOG(LOG_DEBUG, "XR: Reference space change pending (time: %lld; pose valid: %d)", (long long)change->changeTime, change->poseValid);
+
+            rlxr.recenterPending = true;
+            rlxr.recenterTime = change->changeTime;
+            rlxr.recenterPoseValid = change->poseValid;
+            rlxr.recenterPose = change->poseInPreviousSpace;
+
+            break;
+        }
+
+        case XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED:
+            rlxrUpdateCurrentProfiles();
+            break;
+
+        case XR_TYPE_EVENT_DATA_VIVE_TRACKER_CONNECTED_HTCX:
+        {
+            XrPath rolePath = ((XrEventDataViveTrackerConnectedHTCX *)&ev)->paths->rolePath;
+
+            // note: trackers without an assigned role can't be bound to actions
+            if (rolePath != XR_NULL_PATH)
+            {
+                TRACELOG(LOG_INFO, "XR: Vive tracker connected (role: %s)", rlxrPathString(rolePath));
+            } else
+            {
+                TRACELOG(LOG_WARNING, "XR: Vive tracker without a role connected, assign it a role in the runtime settings");
+            }
+            break;
+        }
+
+        case XR_TYPE_EVENT_DATA_DISPLAY_REFRESH_RATE_CHANGED_FB:
+        {
+            XrEventDataDisplayRefreshRateChangedFB *rate = (XrEventDataDisplayRefreshRateChangedFB *)&ev;
+
+            // note: the new display period is picked up by the next xrWaitFrame (frameState.predictedDisplayPeriod)
+            TRACELOG(LOG_INFO, "XR: Display refresh rate changed: %.1f Hz -> %.1f Hz", rate->fromDisplayRefreshRate, rate->toDisplayRefreshRate);
+            rlxr.refreshRate = rate->toDisplayRefreshRate;
+
+            break;
+        }
+
+        case XR_TYPE_EVENT_DATA_PERF_SETTINGS_EXT:
+        {
+            XrEventDataPerfSettingsEXT *perf = (XrEventDataPerfSettingsEXT *)&ev;
+
+            int domain = perf->domain == XR_PERF_SETTINGS_DOMAIN_GPU_EXT ? RLXR_PERF_DOMAIN_GPU : RLXR_PERF_DOMAIN_CPU;
+            int subDomain;
+
+            switch (perf->subDomain)
+            {
+            case XR_PERF_SETTINGS_SUB_DOMAIN_RENDERING_EXT:
+                subDomain = RLXR_PERF_SUBDOMAIN_RENDERING;
+                break;
+
+            case XR_PERF_SETTINGS_SUB_DOMAIN_THERMAL_EXT:
+                subDomain = RLXR_PERF_SUBDOMAIN_THERMAL;
+                break;
+
+            default:
+                subDomain = RLXR_PERF_SUBDOMAIN_COMPOSITING;
+                break;
+            }
+
+            rlPerfNotification level;
+
+            switch (perf->toLevel)
+            {
+            case XR_PERF_SETTINGS_NOTIF_LEVEL_WARNING_EXT:
+                level = RLXR_PERF_NOTIFICATION_WARNING;
+                break;
+
+            case XR_PERF_SETTINGS_NOTIF_LEVEL_IMPAIRED_EXT:
+                level = RLXR_PERF_NOTIFICATION_IMPAIRED;
+                break;
+
+            default:
+                level = RLXR_PERF_NOTIFICATION_NORMAL;
+                break;
+            }
+
+            TRACELOG(level == RLXR_PERF_NOTIFICATION_NORMAL ? LOG_INFO : LOG_WARNING, "XR: Performance notification (domain: %d; sub-domain: %d): %d -> %d", perf->domain, perf->subDomain, perf->fromLevel, perf->toLevel);
+            rlxr.perfNotifications[domain][subDomain] = level;
+
+            break;
+        }
+
+        case XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED:
+        {
+            XrEventDataSessionStateChanged *state = (XrEventDataSessionStateChanged *)&ev;
+            if (rlxr.recording.file) rlxrRecordSessionState(state->state, state->time);
+
+            if (state->state == XR_SESSION_STATE_READY)
+            {
+                // session ready, begin session with view configuration
+                XrSessionBeginInfo beginInfo = {XR_TYPE_SESSION_BEGIN_INFO};
+                beginInfo.primaryViewConfigurationType = rlxr.viewConfig;
+
+                XrResult res = xrBeginSession(rlxr.session, &beginInfo);
+                if (XR_FAILED(res))
+                {
+                    TRACELOG(LOG_ERROR, "XR: Failed to begin session (%s)", rlxrFormatResult(res));
+                    break;
+                }
+#ifndef RLXR_ALLOW_EVENT_WAITING
+                // prevent blocking frame loop on events when running in xr
+                SetWindowState(FLAG_WINDOW_ALWAYS_RUN);
+#endif
+            }
+            if (state->state == XR_SESSION_STATE_STOPPING)
+            {
+                XrResult res = xrEndSession(rlxr.session);
+                if (XR_FAILED(res))
+                {
+                    TRACELOG(LOG_ERROR, "XR: Failed to end session (%s)", rlxrFormatResult(res));
+                    break;
+                }
+#ifndef RLXR_ALLOW_EVENT_WAITING
+                // reallow blocking frame loop on events
+                ClearWindowState(FLAG_WINDOW_ALWAYS_RUN);
+#endif
+            }
+            if (state->state == XR_SESSION_STATE_EXITING)
+            {
+                TRACELOG(LOG_INFO, "XR: Session exiting; rlxr disconnected.");
+
+                rlxr.state = XR_SESSION_STATE_EXITING;
+                break;
+            }
+            if (state->state == XR_SESSION_STATE_LOSS_PENDING)
+            {
+                TRACELOG(LOG_ERROR, "XR: Session loss pending; rlxr disconnected.");
+
+                rlxr.state = XR_SESSION_STATE_LOSS_PENDING;
+                break;
+            }
+
+            TRACELOG(LOG_DEBUG, "XR: Session state changed: %d -> %d", rlxr.state, state->state);
+            rlxr.state = state->state;
+
+            break;
+        }
+
+        default:
+            TRACELOG(LOG_DEBUG, "XR: received unknown event type %d, ignoring", ev.type);
+            break;
+        }
+    }
+
+    if (rlxrIsSessionRunning())
+    {
+        // fill the idle time before the next frame with queued jobs
+
+        rlxrRunJobs();
+
+        if (rlxr.bakedOffsetDirty) rlxrBakeReferenceOffset();
+
+        // sync with xr runtime
+
+        rlxr.frameState.type = XR_TYPE_FRAME_STATE;
+        XrFrameWaitInfo waitInfo = {XR_TYPE_FRAME_WAIT_INFO};
+
+        XrResult res = xrWaitFrame(rlxr.session, &waitInfo, &rlxr.frameState);
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_ERROR, "XR: Failed to wait for a frame (%s)", rlxrFormatResult(res));
+        }
+
+        rlxr.frameWakeTime = rlxrGetMonotonicTime();
+
+        // drop last frames cached locations
+
+        rlxr.locateGeneration++;
+
+        if (rlxr.recenterPending && rlxr.frameState.predictedDisplayTime >= rlxr.recenterTime) rlxrApplyRecenter();
+
+        // sync active action sets
+
+        XrActionsSyncInfo syncInfo = {XR_TYPE_ACTIONS_SYNC_INFO};
+        syncInfo.countActiveActionSets = rlxr.activeSetCount;
+        syncInfo.activeActionSets = rlxr.activeSets;
+
+        res = xrSyncActions(rlxr.session, &syncInfo);
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_WARNING, "XR: Failed to sync actions (%s)", rlxrFormatResult(res));
+        }
+
+#ifndef RLXR_DIRECT_ACTION_QUERIES
+        // snapshot all action states for this frame
+
+        rlxrUpdateActionSamples();
+#endif
+
+        if (rlxr.recording.file) rlxrRecordFrame();
+
+#ifndef RLXR_DIRECT_ACTION_QUERIES
+        // filter the snapshot (after recording, replays are filtered on playback)
+
+        rlxrApplyActionFilters();
+
+        // publish for other threads
+
+        rlxrPublishSnapshot();
+#endif
+
+        // locate tracked hands for this frame
+
+        if (rlxr.ext.handTracking) rlxrUpdateHandJoints();
+
+        // send queued haptics
+
+        if (rlxr.hapticEffectCount != 0) rlxrUpdateHaptics();
+    }
+}
+
+bool IsXrConnected() {
+    if (!rlxr.instance && !rlxr.replay.file) return false;
+    return rlxr.state != XR_SESSION_STATE_LOSS_PENDING && rlxr.state != XR_SESSION_STATE_EXITING;
+}
+
+bool IsXrFocused() {
+    if (!rlxr.instance && !rlxr.replay.file) return false;
+    return rlxr.state == XR_SESSION_STATE_FOCUSED;
+}
+
+rlXrState GetXrState() {
+    if (!rlxr.instance && !rlxr.replay.file) return RLXR_STATE_UNKNOWN;
+
+    switch (rlxr.state)
+    {
+    case XR_SESSION_STATE_IDLE:
+    case XR_SESSION_STATE_READY:
+    case XR_SESSION_STATE_STOPPING:
+        return RLXR_STATE_IDLE;
+
+    case XR_SESSION_STATE_SYNCHRONIZED:
+        return RLXR_STATE_SYNCHRONIZED;
+
+    case XR_SESSION_STATE_VISIBLE:
+        return RLXR_STATE_VISIBLE;
+
+    case XR_SESSION_STATE_FOCUSED:
+        return RLXR_STATE_FOCUSED;
+
+    default:
+        return RLXR_STATE_UNKNOWN;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Frame Timing
+//----------------------------------------------------------------------------------
+
+long long GetXrPredictedDisplayTime() {
+    return rlxr.frameState.predictedDisplayTime;
+}
+
+long long GetXrDisplayPeriod() {
+    return rlxr.frameState.predictedDisplayPeriod;
+}
+
+long long GetXrCurrentTime() {
+    if (!rlxr.instance) return 0;
+    return rlxrClockToXrTime(rlxrGetMonotonicTime());
+}
+
+long long ConvertXrTimeToClock(long long time) {
+    if (!rlxr.instance) return 0;
+    return rlxrXrTimeToClock(time);
+}
+
+long long ConvertClockToXrTime(long long time) {
+    if (!rlxr.instance) return 0;
+    return rlxrClockToXrTime(time);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Display
+//----------------------------------------------------------------------------------
+
+int GetXrRefreshRates(float *rates, int maxCount) {
+    if (!rlxr.instance || !rlxr.ext.displayRefreshRate || maxCount <= 0) return 0;
+
+    unsigned int count = rlxr.refreshRateCount < (unsigned int)maxCount ? rlxr.refreshRateCount : (unsigned int)maxCount;
+    memcpy(rates, rlxr.refreshRates, count * sizeof(float));
+
+    return (int)count;
+}
+
+bool SetXrRefreshRate(float rate) {
+    if (!rlxr.instance || !rlxr.ext.displayRefreshRate) return false;
+
+    XrResult res = rlxr.pfn.RequestDisplayRefreshRateFB(rlxr.session, rate);
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_WARNING, "XR: Failed to request display refresh rate %.1f Hz (%s)", rate, rlxrFormatResult(res));
+        return false;
+    }
+
+    // note: rlxr.refreshRate is updated once the runtime confirms the change with an event
+    return true;
+}
+
+float GetXrRefreshRate() {
+    if (!rlxr.instance) return 0.f;
+    return rlxr.refreshRate;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Performance
+//----------------------------------------------------------------------------------
+
+bool SetXrPerfLevel(rlPerfDomain domain, rlPerfLevel level) {
+    if (!rlxr.instance || !rlxr.ext.perfSettings) return false;
+
+    if ((unsigned int)domain > RLXR_PERF_DOMAIN_GPU || (unsigned int)level > RLXR_PERF_LEVEL_BOOST)
+    {
+        TRACELOG(LOG_WARNING, "XR: Invalid performance domain (%d) or level (%d)", (int)domain, (int)level);
+        return false;
+    }
+
+    static const XrPerfSettingsLevelEXT levels[] = {
+        XR_PERF_SETTINGS_LEVEL_POWER_SAVINGS_EXT,
+        XR_PERF_SETTINGS_LEVEL_SUSTAINED_LOW_EXT,
+        XR_PERF_SETTINGS_LEVEL_SUSTAINED_HIGH_EXT,
+        XR_PERF_SETTINGS_LEVEL_BOOST_EXT,
+    };
+
+    XrPerfSettingsDomainEXT xrDomain = domain == RLXR_PERF_DOMAIN_GPU ? XR_PERF_SETTINGS_DOMAIN_GPU_EXT : XR_PERF_SETTINGS_DOMAIN_CPU_EXT;
+
+    XrResult res = rlxr.pfn.PerfSettingsSetPerformanceLevelEXT(rlxr.session, xrDomain, levels[level]);
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_WARNING, "XR: Failed to set performance level (%s)", rlxrFormatResult(res));
+        return false;
+    }
+
+    return true;
+}
+
+rlPerfNotification GetXrPerfNotification(rlPerfDomain domain, rlPerfSubDomain subDomain) {
+    if (!rlxr.instance) return RLXR_PERF_NOTIFICATION_NORMAL;
+    if ((unsigned int)domain > RLXR_PERF_DOMAIN_GPU || (unsigned int)subDomain > RLXR_PERF_SUBDOMAIN_THERMAL) return RLXR_PERF_NOTIFICATION_NORMAL;
+
+    return rlxr.perfNotifications[domain][subDomain];
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Job Scheduling
+//----------------------------------------------------------------------------------
+
+bool EnqueueXrJob(rlXrJobFunc func, void *userData, long budget) {
+    if (!rlxr.instance && !rlxr.replay.file) return false;
+
+    if (rlxr.frameState.predictedDisplayPeriod != 0 && budget > rlxr.frameState.predictedDisplayPeriod - RLXR_JOB_SAFETY_MARGIN)
+    {
+        TRACELOG(LOG_WARNING, "XR: Job budget (%ld ns) exceeds the frame period, job rejected", budget);
+        return false;
+    }
+
+    unsigned int jobIdx = rlxr.jobCount;
+    rlxrResizeArray((void **)&rlxr.jobs, &rlxr.jobCount, &rlxr.jobCap, rlxr.jobCount + 1, sizeof(rlxrJob));
+
+    rlxr.jobs[jobIdx] = (rlxrJob){func, userData, budget};
+    return true;
+}
+
+int GetXrPendingJobCount() {
+    return rlxr.jobCount;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Latency Instrumentation
+//----------------------------------------------------------------------------------
+
+static bool rlxrLoadTimerFunctions() {
+    rlxrLatencyLog *log = &rlxr.latency;
+
+#if defined(XR_USE_GRAPHICS_API_OPENGL_ES)
+    log->GenQueries = glGenQueries;
+    log->DeleteQueries = glDeleteQueries;
+    log->GetQueryObjectuiv = glGetQueryObjectuiv;
+    log->GetInteger64v = glGetInteger64v;
+    log->QueryCounter = (PFNGLQUERYCOUNTEREXTPROC)eglGetProcAddress("glQueryCounterEXT");
+    log->GetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VEXTPROC)eglGetProcAddress("glGetQueryObjectui64vEXT");
+#elif defined(XR_USE_PLATFORM_WIN32)
+    log->GenQueries = (PFNGLGENQUERIESPROC)wglGetProcAddress("glGenQueries");
+    log->DeleteQueries = (PFNGLDELETEQUERIESPROC)wglGetProcAddress("glDeleteQueries");
+    log->GetQueryObjectuiv = (PFNGLGETQUERYOBJECTUIVPROC)wglGetProcAddress("glGetQueryObjectuiv");
+    log->GetInteger64v = (PFNGLGETINTEGER64VPROC)wglGetProcAddress("glGetInteger64v");
+    log->QueryCounter = (PFNGLQUERYCOUNTERPROC)wglGetProcAddress("glQueryCounter");
+    log->GetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)wglGetProcAddress("glGetQueryObjectui64v");
+#elif defined(XR_USE_PLATFORM_XLIB)
+    log->GenQueries = (PFNGLGENQUERIESPROC)glXGetProcAddress((const GLubyte *)"glGenQueries");
+    log->DeleteQueries = (PFNGLDELETEQUERIESPROC)glXGetProcAddress((const GLubyte *)"glDeleteQueries");
+    log->GetQueryObjectuiv = (PFNGLGETQUERYOBJECTUIVPROC)glXGetProcAddress((const GLubyte *)"glGetQueryObjectuiv");
+    log->GetInteger64v = (PFNGLGETINTEGER64VPROC)glXGetProcAddress((const GLubyte *)"glGetInteger64v");
+    log->QueryCounter = (PFNGLQUERYCOUNTERPROC)glXGetProcAddress((const GLubyte *)"glQueryCounter");
+    log->GetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)glXGetProcAddress((const GLubyte *)"glGetQueryObjectui64v");
+#endif
+
+    return log->GenQueries && log->DeleteQueries && log->GetQueryObjectuiv && log->GetInteger64v && log->QueryCounter && log->GetQueryObjectui64v;
+}
+
+static void rlxrFlushLatencyFrames(unsigned int maxPending) {
+    // writes ended frames in order as their GPU timestamps become available,
+    // only waits for a timestamp if more than [maxPending] frames would stay unwritten
+
+    rlxrLatencyLog *log = &rlxr.latency;
+
+    while (log->flushIndex != log->frameIndex)
+    {
+        rlxrLatencyFrame *frame = &log->frames[log->flushIndex % RLXR_LATENCY_FRAMES];
+
+        int64_t gpuDoneTime = 0;
+        if (frame->queryIssued)
+        {
+            GLuint available = GL_FALSE;
+            log->GetQueryObjectuiv(frame->query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available && log->frameIndex - log->flushIndex <= maxPending) break;
+
+            GLuint64 gpuTime = 0;
+            log->GetQueryObjectui64v(frame->query, GL_QUERY_RESULT, &gpuTime);
+            gpuDoneTime = (int64_t)gpuTime + frame->clockOffset;
+        }
+
+        int64_t displayTime = rlxrXrTimeToClock(frame->displayTime);
+        int64_t motionToPhoton = displayTime != 0 && frame->locateTime != 0 ? displayTime - frame->locateTime : 0;
+
+        fprintf(log->file, "%u,%lld,%lld,%lld,%lld,%lld,%lld,%lld\n", log->flushIndex,
+                (long long)frame->wakeTime, (long long)frame->locateTime, (long long)gpuDoneTime, (long long)displayTime,
+                (long long)frame->displayTime, (long long)frame->displayPeriod, (long long)motionToPhoton);
+
+        log->flushIndex++;
+    }
+}
+
+static void rlxrWriteLatencyRecord() {
+    rlxrLatencyLog *log = &rlxr.latency;
+
+    rlxrLatencyFrame *frame = &log->frames[log->frameIndex % RLXR_LATENCY_FRAMES];
+    frame->wakeTime = rlxr.frameWakeTime;
+    frame->locateTime = log->locateTime;
+    frame->displayTime = rlxr.frameState.predictedDisplayTime;
+    frame->displayPeriod = rlxr.frameState.predictedDisplayPeriod;
+
+    log->frameIndex++;
+    log->locateTime = 0;
+
+    // the GPU usually finishes a frame while the next ones are being recorded, so the record is written
+    // once its timestamp query is available (without stalling the CPU), the slot of the next frame is freed
+
+    rlxrFlushLatencyFrames(RLXR_LATENCY_FRAMES - 1);
+    log->frames[log->frameIndex % RLXR_LATENCY_FRAMES].queryIssued = false;
+}
+
+bool StartXrLatencyLog(const char *fileName) {
+    if (!rlxr.instance) return false;
+    if (rlxr.latency.file) StopXrLatencyLog();
+
+    if (!rlxrLoadTimerFunctions())
+    {
+        TRACELOG(LOG_WARNING, "XR: GL timer queries not supported, cannot measure latency");
+        return false;
+    }
+
+    if (!rlxr.ext.convertTime)
+    {
+        TRACELOG(LOG_WARNING, "XR: Runtime doesn't support clock conversion, display times will not be logged");
+    }
+
+    rlxr.latency.file = fopen(fileName, "w");
+    if (!rlxr.latency.file)
+    {
+        TRACELOG(LOG_WARNING, "XR: Failed to open latency log %s", fileName);
+        return false;
+    }
+
+    // note: all *_ns columns are system monotonic clock times, xr_* columns are raw runtime values
+    fprintf(rlxr.latency.file, "frame,wait_return_ns,locate_views_ns,gpu_done_ns,display_ns,xr_display_time,xr_display_period,motion_to_photon_ns\n");
+
+    rlxr.latency.frameIndex = 0;
+    rlxr.latency.flushIndex = 0;
+    rlxr.latency.locateTime = 0;
+
+    for (int i = 0; i < RLXR_LATENCY_FRAMES; i++)
+    {
+        rlxr.latency.GenQueries(1, &rlxr.latency.frames[i].query);
+        rlxr.latency.frames[i].queryIssued = false;
+    }
+
+    TRACELOG(LOG_INFO, "XR: Latency log started (%s)", fileName);
+    return true;
+}
+
+void StopXrLatencyLog() {
+    if (!rlxr.latency.file) return;
+
+    // (waits for the frames still in flight)
+    rlxrFlushLatencyFrames(0);
+
+    for (int i = 0; i < RLXR_LATENCY_FRAMES; i++)
+    {
+        rlxr.latency.DeleteQueries(1, &rlxr.latency.frames[i].query);
+    }
+
+    fclose(rlxr.latency.file);
+    rlxr.latency.file = NULL;
+
+    TRACELOG(LOG_INFO, "XR: Latency log stopped (%u frames)", rlxr.latency.frameIndex);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Recording and Replay
+//----------------------------------------------------------------------------------
+
+// note: a recording is a rlxrRecordingHeader followed by tagged chunks (uint32 tag, uint32 size, payload), every
+//       running frame writes a FRAM and an ACTS chunk (and a VIEW chunk from BeginXrMode), session state changes
+//       are written as EVNT chunks. payloads are raw structs, so recordings are only replayable by a matching build.
+
+bool StartXrRecording(const char *fileName) {
+#ifdef RLXR_DIRECT_ACTION_QUERIES
+    TRACELOG(LOG_WARNING, "XR: Recording requires the action snapshot, not supported with RLXR_DIRECT_ACTION_QUERIES");
+    return false;
+#else
+    if (!rlxr.instance) return false;
+    if (rlxr.recording.file) StopXrRecording();
+
+    rlxr.recording.file = fopen(fileName, "wb");
+    if (!rlxr.recording.file)
+    {
+        TRACELOG(LOG_WARNING, "XR: Failed to open recording %s", fileName);
+        return false;
+    }
+
+    rlxrRecordingHeader header = {0};
+    header.magic = RLXR_RECORDING_MAGIC;
+    header.version = RLXR_RECORDING_VERSION;
+    header.sampleSize = sizeof(rlxrActionSample);
+    header.viewCount = rlxr.viewCount;
+    header.flags = (rlxr.ext.eyeGaze ? RLXR_RECORDING_EYE_GAZE : 0) | (rlxr.ext.viveTracker ? RLXR_RECORDING_VIVE_TRACKER : 0);
+
+    fwrite(&header, sizeof(header), 1, rlxr.recording.file);
+
+    // start from the current session state, following changes are recorded as they are polled
+    rlxrRecordSessionState(rlxr.state, rlxr.frameState.predictedDisplayTime);
+
+    rlxr.recording.frameCount = 0;
+
+    TRACELOG(LOG_INFO, "XR: Recording started (%s)", fileName);
+    return true;
+#endif
+}
+
+void StopXrRecording() {
+    if (!rlxr.recording.file) return;
+
+    fclose(rlxr.recording.file);
+    rlxr.recording.file = NULL;
+
+    TRACELOG(LOG_INFO, "XR: Recording stopped (%d frames)", rlxr.recording.frameCount);
+}
+
+bool InitXrReplay(const char *fileName) {
+#ifdef RLXR_DIRECT_ACTION_QUERIES
+    TRACELOG(LOG_WARNING, "XR: Replays require the action snapshot, not supported with RLXR_DIRECT_ACTION_QUERIES");
+    return false;
+#else
+    if (rlxr.replay.file) return true;
+    if (rlxr.instance)
+    {
+        TRACELOG(LOG_WARNING, "XR: Cannot replay while connected to a runtime, call InitXrReplay instead of InitXr");
+        return false;
+    }
+
+    FILE *file = fopen(fileName, "rb");
+    if (!file)
+    {
+        TRACELOG(LOG_WARNING, "XR: Failed to open replay %s", fileName);
+        return false;
+    }
+
+    rlxrRecordingHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != RLXR_RECORDING_MAGIC || header.version != RLXR_RECORDING_VERSION ||
+        header.sampleSize != sizeof(rlxrActionSample) || header.viewCount == 0)
+    {
+        TRACELOG(LOG_WARNING, "XR: %s is not a recording made by this build of rlxr", fileName);
+
+        fclose(file);
+        return false;
+    }
+
+    memset(&rlxr, 0, sizeof(rlxr));
+    rlxr.replay.file = file;
+
+    rlxr.viewCount = header.viewCount;
+    rlxr.views = (XrView *)RL_CALLOC(rlxr.viewCount, sizeof(XrView));
+
+    for (unsigned int i = 0; i < rlxr.viewCount; i++)
+    {
+        rlxr.views[i].type = XR_TYPE_VIEW;
+        rlxr.views[i].pose.orientation.w = 1.f;
+    }
+
+    // recreate the internal action layout of the recorded session (the primary set and eye gaze action are created before any app action)
+
+    rlxr.ext.eyeGaze = header.flags & RLXR_RECORDING_EYE_GAZE;
+    rlxr.ext.viveTracker = header.flags & RLXR_RECORDING_VIVE_TRACKER;
+
+    rlxrCreateActionSet("rlxr-primary-set", RLXR_APP_NAME " Primary Input", 0);
+
+    rlxr.currentActionSet = RLXR_PRIMARY_ACTION_SET;
+    rlxrRebuildActiveSets();
+
+    rlxrInitEyeGaze();
+
+    rlxr.state = XR_SESSION_STATE_IDLE;
+
+    rlxr.refPosition = (Vector3){0.f, 0.f, 0.f};
+    rlxr.refOrientation = (Quaternion){0.f, 0.f, 0.f, 1.f};
+    rlxr.offsetPosition = rlxr.refPosition;
+    rlxr.offsetOrientation = rlxr.refOrientation;
+
+    rlxr.frameActive = false;
+    rlxr.viewActiveIndex = ~0;
+
+    TRACELOG(LOG_INFO, "XR: Replaying %s (%d views, no runtime)", fileName, rlxr.viewCount);
+    return true;
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Space and Poses
+//----------------------------------------------------------------------------------
+
+static rlPose xrPoseToRlPoseOffset(XrPosef xrPose, bool position, bool orientation, Vector3 refPosition, Quaternion refOrientation) {
+    // applies the reference offset as a rigid transform, positions are rotated by [refOrientation] before being offset
+    rlPose pose;
+    pose.position = (Vector3){0.f, 0.f, 0.f};
+    pose.orientation = (Quaternion){0.f, 0.f, 0.f, 1.f};
+    pose.isPositionValid = false;
+    pose.isOrientationValid = false;
+
+    if (position)
+    {
+        pose.position = (Vector3){xrPose.position.x, xrPose.position.y, xrPose.position.z};
+        pose.position = Vector3Add(refPosition, Vector3RotateByQuaternion(pose.position, refOrientation));
+        pose.isPositionValid = true;
+    }
+
+    if (orientation)
+    {
+        pose.orientation = (Quaternion){xrPose.orientation.x, xrPose.orientation.y, xrPose.orientation.z, xrPose.orientation.w};
+        pose.orientation = QuaternionMultiply(refOrientation, pose.orientation);
+        pose.isOrientationValid = true;
+    }
+
+    return pose;
+}
+
+static rlPose xrPoseToRlPose(XrPosef xrPose, bool position, bool orientation) {
+    return xrPoseToRlPoseOffset(xrPose, position, orientation, rlxr.offsetPosition, rlxr.offsetOrientation);
+}
+
+static rlVelocity xrVelocityToRlVelocityOffset(XrSpaceVelocityFlags flags, XrVector3f linear, XrVector3f angular, Quaternion refOrientation) {
+    // note: both velocities are rotated by the reference offset (see xrPoseToRlPose)
+    rlVelocity velocity = {0};
+
+    if (flags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT)
+    {
+        velocity.linear = Vector3RotateByQuaternion((Vector3){linear.x, linear.y, linear.z}, refOrientation);
+        velocity.isLinearValid = true;
+    }
+
+    if (flags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT)
+    {
+        velocity.angular = Vector3RotateByQuaternion((Vector3){angular.x, angular.y, angular.z}, refOrientation);
+        velocity.isAngularValid = true;
+    }
+
+    return velocity;
+}
+
+static rlVelocity xrVelocityToRlVelocity(XrSpaceVelocityFlags flags, XrVector3f linear, XrVector3f angular) {
+    return xrVelocityToRlVelocityOffset(flags, linear, angular, rlxr.offsetOrientation);
+}
+
+rlPose GetXrViewPose() {
+    return GetXrViewPoseAt(rlxr.frameState.predictedDisplayTime);
+}
+
+rlVelocity GetXrViewVelocity() {
+    if ((rlxr.viewLocationTime == rlxr.frameState.predictedDisplayTime && rlxr.viewLocationTime != 0) || rlxr.replay.file)
+    {
+        // already located in this frames action snapshot
+        return xrVelocityToRlVelocity(rlxr.viewVelocity.velocityFlags, rlxr.viewVelocity.linearVelocity, rlxr.viewVelocity.angularVelocity);
+    }
+
+    XrSpaceLocation location;
+    XrSpaceVelocity velocity;
+    rlxrLocateSpaces(&rlxr.viewSpace, 1, rlxr.frameState.predictedDisplayTime, &location, &velocity);
+
+    return xrVelocityToRlVelocity(velocity.velocityFlags, velocity.linearVelocity, velocity.angularVelocity);
+}
+
+rlPose ExtrapolateXrPose(rlPose pose, rlVelocity velocity, float dt) {
+    if (velocity.isLinearValid && pose.isPositionValid)
+    {
+        pose.position = Vector3Add(pose.position, Vector3Scale(velocity.linear, dt));
+    }
+
+    float speed = Vector3Length(velocity.angular);
+    if (velocity.isAngularValid && pose.isOrientationValid && speed > 1e-6f)
+    {
+        // angular velocity is in the base space, rotate before the current orientation
+        Quaternion delta = QuaternionFromAxisAngle(Vector3Scale(velocity.angular, 1.f / speed), speed * dt);
+        pose.orientation = QuaternionNormalize(QuaternionMultiply(delta, pose.orientation));
+    }
+
+    return pose;
+}
+
+rlPose GetXrViewPoseAt(long long time) {
+    XrSpaceLocation location = {XR_TYPE_SPACE_LOCATION};
+
+    if ((time == rlxr.viewLocationTime && time != 0) || rlxr.replay.file)
+    {
+        // already located in this frames action snapshot (the only location available when replaying)
+        location = rlxr.viewLocation;
+        return xrPoseToRlPose(location.pose, location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT, location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT);
+    }
+
+    rlxrLocateSpaces(&rlxr.viewSpace, 1, time, &location, NULL);
+
+    return xrPoseToRlPose(location.pose, location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT, location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT);
+}
+
+static void rlxrSetReferenceOffset(Vector3 position, Quaternion orientation) {
+#if defined(RLXR_BAKE_REFERENCE_OFFSET)
+    if (!rlxr.replay.file)
+    {
+        bool changed = position.x != rlxr.refPosition.x || position.y != rlxr.refPosition.y || position.z != rlxr.refPosition.z ||
+                       orientation.x != rlxr.refOrientation.x || orientation.y != rlxr.refOrientation.y || orientation.z != rlxr.refOrientation.z || orientation.w != rlxr.refOrientation.w;
+        if (!changed) return;
+
+        // (the reference space is recreated by the next UpdateXr, views of the current frame stay in the old one)
+
+        rlxr.refPosition = position;
+        rlxr.refOrientation = orientation;
+        rlxr.bakedOffsetDirty = true;
+        return;
+    }
+#endif
+
+    rlxr.refPosition = position;
+    rlxr.refOrientation = orientation;
+    rlxr.offsetPosition = position;
+    rlxr.offsetOrientation = orientation;
+}
+
+void SetXrPosition(Vector3 pos) {
+    rlxrSetReferenceOffset(pos, rlxr.refOrientation);
+}
+
+void SetXrOrientation(Quaternion quat) {
+    rlxrSetReferenceOffset(rlxr.refPosition, quat);
+}
+
+rlPose GetXrPose() {
+    return (rlPose){rlxr.refPosition, rlxr.refOrientation};
+}
+
+bool SetXrReference(rlReferenceType type) {
+    XrPosef pose = {{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+
+#if defined(RLXR_BAKE_REFERENCE_OFFSET)
+    // (keep the baked offset, but not the recenter compensation of the previous space)
+    pose = rlxrInvertPose(rlxr.bakedOffset);
+#endif
+
+    if (!rlxrCreateReferenceSpace(type, pose))
+    {
+        TRACELOG(LOG_WARNING, "XR: Failed to switch reference type");
+        return false;
+    }
+
+    // (a pending change of the previous space doesn't apply to the new one)
+    rlxr.recenterPending = false;
+
+    return true;
+}
+
+rlReferenceType GetXrReference() {
+    return rlxr.referenceType;
+}
+
+bool IsXrRecentered() {
+    return rlxr.recentered;
+}
+
+rlPose GetXrRecenterPose() {
+    XrPosef pose = rlxr.recenterPose;
+    bool valid = rlxr.recenterTime != 0 && rlxr.recenterPoseValid;
+
+    if (!valid) return (rlPose){{0.f, 0.f, 0.f}, {0.f, 0.f, 0.f, 1.f}, false, false};
+
+    return (rlPose){{pose.position.x, pose.position.y, pose.position.z}, {pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w}, true, true};
+}
+
+long long GetXrRecenterTime() {
+    return rlxr.recenterPending ? 0 : rlxr.recenterTime;
+}
+
+void SetXrRecenterCompensation(bool enabled) {
+    rlxr.recenterCompensation = enabled;
+}
+
+static bool rlxrQueryPlayArea() {
+    // queries the play area bounds until the runtime reports them (once per frame, runtimes often don't have them
+    // before tracking starts), then keeps them until the STAGE space changes, returns false if unavailable
+
+    if (rlxr.replay.file || rlxr.session == XR_NULL_HANDLE) return false;
+    if (rlxr.playAreaValid) return true;
+
+    if (rlxr.playAreaQueryGeneration == rlxr.locateGeneration + 1) return false;
+    rlxr.playAreaQueryGeneration = rlxr.locateGeneration + 1;
+
+    XrExtent2Df bounds = {0.0f, 0.0f};
+    XrResult res = xrGetReferenceSpaceBoundsRect(rlxr.session, XR_REFERENCE_SPACE_TYPE_STAGE, &bounds);
+    if (XR_FAILED(res) || res == XR_SPACE_BOUNDS_UNAVAILABLE || bounds.width <= 0.0f || bounds.height <= 0.0f)
+    {
+        TRACELOGD("XR: Play area bounds unavailable (%s)", rlxrFormatResult(res));
+        return false;
+    }
+
+    TRACELOG(LOG_INFO, "XR: Play area bounds: %.2fm x %.2fm", bounds.width, bounds.height);
+
+    rlxr.playArea = bounds;
+    rlxr.playAreaValid = true;
+
+    return true;
+}
+
+Vector2 GetXrPlayAreaBounds() {
+    if (!rlxrQueryPlayArea()) return (Vector2){0.0f, 0.0f};
+
+    return (Vector2){rlxr.playArea.width, rlxr.playArea.height};
+}
+
+float GetXrPlayAreaDistance(Vector3 position) {
+    if (!rlxrQueryPlayArea()) return FLT_MAX;
+
+    if (rlxr.stageSpace == XR_NULL_HANDLE)
+    {
+        XrReferenceSpaceCreateInfo stageInfo = {XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+        stageInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_STAGE;
+        stageInfo.poseInReferenceSpace = (XrPosef){{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+
+        XrResult res = xrCreateReferenceSpace(rlxr.session, &stageInfo, &rlxr.stageSpace);
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_WARNING, "XR: Failed to create stage space (%s)", rlxrFormatResult(res));
+
+            rlxr.stageSpace = XR_NULL_HANDLE;
+            return FLT_MAX;
+        }
+    }
+
+    // locate the stage origin in the reference space (cached per frame, so querying multiple poses is cheap)
+
+    XrSpaceLocation stage;
+    rlxrLocateSpaces(&rlxr.stageSpace, 1, rlxr.frameState.predictedDisplayTime, &stage, NULL);
+
+    const XrSpaceLocationFlags valid = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+    if ((stage.locationFlags & valid) != valid) return FLT_MAX;
+
+    // move the position into the stage space
+
+    Quaternion stageInverse = QuaternionInvert((Quaternion){stage.pose.orientation.x, stage.pose.orientation.y, stage.pose.orientation.z, stage.pose.orientation.w});
+    Vector3 local = Vector3RotateByQuaternion(Vector3Subtract(position, rlxr.offsetPosition), QuaternionInvert(rlxr.offsetOrientation));
+    local = Vector3RotateByQuaternion(Vector3Subtract(local, (Vector3){stage.pose.position.x, stage.pose.position.y, stage.pose.position.z}), stageInverse);
+
+    // signed distance to the rectangle edge (on the XZ plane)
+
+    float dx = fabsf(local.x) - rlxr.playArea.width * 0.5f;
+    float dz = fabsf(local.z) - rlxr.playArea.height * 0.5f;
+
+    if (dx <= 0.0f && dz <= 0.0f) return -fmaxf(dx, dz);
+
+    return -sqrtf(fmaxf(dx, 0.0f) * fmaxf(dx, 0.0f) + fmaxf(dz, 0.0f) * fmaxf(dz, 0.0f));
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Hand Tracking
+//----------------------------------------------------------------------------------
+
+bool IsXrHandTrackingSupported() {
+    return rlxr.instance && rlxr.ext.handTracking;
+}
+
+bool GetXrHandJoints(rlActionDevices hand, rlHandJoints *joints) {
+    if (!rlxr.instance || !rlxr.ext.handTracking || (hand != RLXR_HAND_LEFT && hand != RLXR_HAND_RIGHT))
+    {
+        memset(joints, 0, sizeof(rlHandJoints));
+        return false;
+    }
+
+    *joints = rlxr.handJoints[hand == RLXR_HAND_LEFT ? 0 : 1];
+    return joints->active;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Eye Gaze
+//----------------------------------------------------------------------------------
+
+bool IsXrEyeGazeSupported() {
+    return (rlxr.instance || rlxr.replay.file) && rlxr.ext.eyeGaze;
+}
+
+rlPoseState GetXrGaze() {
+    if ((!rlxr.instance && !rlxr.replay.file) || !rlxr.actionSetAttached || rlxr.gazeAction == RLXR_NULL_ACTION) return (rlPoseState){(rlPose){{}, {}, 0, 0}, false};
+
+    return rlGetPoseState(rlxr.gazeAction, RLXR_DEVICE_EYES);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - View Rendering
+//----------------------------------------------------------------------------------
+
+// =============================================================================
+// math code adapted from
+// https://github.com/KhronosGroup/OpenXR-SDK-Source/blob/master/src/common/xr_linear.h
+// Copyright (c) 2017 The Khronos Group Inc.
+// Copyright (c) 2016 Oculus VR, LLC.
+// SPDX-License-Identifier: Apache-2.0
+// =============================================================================
+
+typedef enum {
+    GRAPHICS_VULKAN,
+    GRAPHICS_OPENGL,
+    GRAPHICS_OPENGL_ES
+} GraphicsAPI;
+
+inline static void
+XrMatrix4x4f_CreateProjectionFov(Matrix *result,
+                                 GraphicsAPI graphicsApi,
+                                 const XrFovf fov,
+                                 const float nearZ,
+                                 const float farZ) {
+    const float tanAngleLeft = tanf(fov.angleLeft);
+    const float tanAngleRight = tanf(fov.angleRight);
+
+    const float tanAngleDown = tanf(fov.angleDown);
+    const float tanAngleUp = tanf(fov.angleUp);
+
+    const float tanAngleWidth = tanAngleRight - tanAngleLeft;
+
+    // Set to tanAngleDown - tanAngleUp for a clip space with positive Y
+    // down (Vulkan). Set to tanAngleUp - tanAngleDown for a clip space with
+    // positive Y up (OpenGL / D3D / Metal).
+    const float tanAngleHeight =
+        graphicsApi == GRAPHICS_VULKAN ? (tanAngleDown - tanAngleUp) : (tanAngleUp - tanAngleDown);
+
+    // Set to nearZ for a [-1,1] Z clip space (OpenGL / OpenGL ES).
+    // Set to zero for a [0,1] Z clip space (Vulkan / D3D / Metal).
+    const float offsetZ =
+        (graphicsApi == GRAPHICS_OPENGL || graphicsApi == GRAPHICS_OPENGL_ES) ? nearZ : 0;
+
+    if (farZ <= nearZ)
+    {
+        // place the far plane at infinity
+        result->m0 = 2 / tanAngleWidth;
+        result->m4 = 0;
+        result->m8 = (tanAngleRight + tanAngleLeft) / tanAngleWidth;
+        result->m12 = 0;
+
+        result->m1 = 0;
+        result->m5 = 2 / tanAngleHeight;
+        result->m9 = (tanAngleUp + tanAngleDown) / tanAngleHeight;
+        result->m13 = 0;
+
+        result->m2 = 0;
+        result->m6 = 0;
+        result->m10 = -1;
+        result->m14 = -(nearZ + offsetZ);
+
+        result->m3 = 0;
+        result->m7 = 0;
+        result->m11 = -1;
+        result->m15 = 0;
+    } else
+    {
+        // normal projection
+        result->m0 = 2 / tanAngleWidth;
+        result->m4 = 0;
+        result->m8 = (tanAngleRight + tanAngleLeft) / tanAngleWidth;
+        result->m12 = 0;
+
+        result->m1 = 0;
+        result->m5 = 2 / tanAngleHeight;
+        result->m9 = (tanAngleUp + tanAngleDown) / tanAngleHeight;
+        result->m13 = 0;
+
+        result->m2 = 0;
+        result->m6 = 0;
+        result->m10 = -(farZ + offsetZ) / (farZ - nearZ);
+        result->m14 = -(farZ * (nearZ + offsetZ)) / (farZ - nearZ);
+
+        result->m3 = 0;
+        result->m7 = 0;
+        result->m11 = -1;
+        result->m15 = 0;
+    }
+}
+
+int BeginXrMode() {
+    assert(!rlxr.frameActive);
+
+    if (rlxr.replay.file)
+    {
+        // no runtime frame to begin, the views were already read by UpdateXr
+
+        if (rlxr.replay.frameCount == 0 || !IsXrConnected()) return 0;
+
+        rlxr.frameActive = true;
+        rlxr.viewActiveIndex = ~0;
+
+        return rlxr.frameState.shouldRender ? rlxr.viewCount : 0;
+    }
+
+    if (!rlxrIsSessionRunning()) return 0; // session not yet synchronized, skip this frame
+
+    // locate view poses
+
+    XrViewState viewState = {XR_TYPE_VIEW_STATE};
+    XrViewLocateInfo locateInfo = {XR_TYPE_VIEW_LOCATE_INFO};
+    locateInfo.viewConfigurationType = rlxr.viewConfig;
+    locateInfo.displayTime = rlxr.frameState.predictedDisplayTime;
+    locateInfo.space = rlxr.referenceSpace;
+
+    if (rlxr.latency.file) rlxr.latency.locateTime = rlxrGetMonotonicTime();
+
+    XrResult res = xrLocateViews(rlxr.session, &locateInfo, &viewState, rlxr.viewCount, &rlxr.viewCount, rlxr.views);
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to locate views (%s)", rlxrFormatResult(res));
+    }
+
+    if (rlxr.recording.file) rlxrRecordViews();
+
+    // begin frame
+
+    XrFrameBeginInfo beginInfo = {XR_TYPE_FRAME_BEGIN_INFO};
+
+    res = xrBeginFrame(rlxr.session, &beginInfo);
+    if (XR_FAILED(res))
+    {
+        if (res == XR_ERROR_SESSION_LOST || res == XR_ERROR_INSTANCE_LOST)
+        {
+            // in the case that the app doesn't gracefully receive a _LOSS_PENDING event, we have to
+            // make sure we _eventually_ close the XR connection, clean up and make it visible to the
+            // app (using IsXrConnected)
+
+            rlxr.state = XR_SESSION_STATE_LOSS_PENDING;
+        }
+
+        TRACELOG(LOG_ERROR, "XR: Failed to begin a frame (%s)", rlxrFormatResult(res));
+        return 0;
+    }
+
+    rlxr.frameActive = true;
+    rlxr.viewActiveIndex = ~0;
+
+    if (!rlxr.frameState.shouldRender) return 0; // runtime requested to not render anything, skip views for this frame
+
+    return rlxr.viewCount;
+}
+
+void EndXrMode() {
+    if (!rlxr.frameActive) return;
+    assert(rlxr.viewActiveIndex == ~0);
+
+    if (rlxr.replay.file)
+    {
+        rlxr.frameActive = false;
+        return;
+    }
+
+    // end frame and submit layer(s)
+
+    XrCompositionLayerProjection layer = {XR_TYPE_COMPOSITION_LAYER_PROJECTION};
+    layer.layerFlags = 0;
+    layer.space = rlxr.referenceSpace;
+    layer.viewCount = rlxr.viewCount;
+    layer.views = rlxr.projectionViews;
+
+    const XrCompositionLayerBaseHeader *submit_layers[1] = {(XrCompositionLayerBaseHeader *)&layer};
+
+    XrFrameEndInfo endInfo = {XR_TYPE_FRAME_END_INFO};
+    endInfo.displayTime = rlxr.frameState.predictedDisplayTime;
+    endInfo.layerCount = rlxr.frameState.shouldRender ? 1 : 0;
+    endInfo.layers = submit_layers;
+    endInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE; // TODO: add support for env blend modes
+
+    XrResult res = xrEndFrame(rlxr.session, &endInfo);
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to end a frame (%s)", rlxrFormatResult(res));
+    }
+
+    if (rlxr.latency.file) rlxrWriteLatencyRecord();
+
+    rlxr.frameActive = false;
+}
+
+static void rlxrSetupViewCamera(unsigned int index) {
+    Matrix xr_proj;
+    XrMatrix4x4f_CreateProjectionFov(&xr_proj, GRAPHICS_OPENGL, rlxr.views[index].fov, rlGetCullDistanceNear(), rlGetCullDistanceFar());
+    rlSetMatrixProjection(xr_proj);
+
+    Vector3 pos = Vector3Add(rlxr.offsetPosition, Vector3RotateByQuaternion((Vector3){rlxr.views[index].pose.position.x, rlxr.views[index].pose.position.y, rlxr.views[index].pose.position.z}, rlxr.offsetOrientation));
+    Quaternion quat = QuaternionMultiply(rlxr.offsetOrientation, (Quaternion){rlxr.views[index].pose.orientation.x, rlxr.views[index].pose.orientation.y, rlxr.views[index].pose.orientation.z, rlxr.views[index].pose.orientation.w});
+
+    Matrix xr_view = MatrixMultiply(QuaternionToMatrix(quat), MatrixTranslate(pos.x, pos.y, pos.z));
+    xr_view = MatrixInvert(xr_view);
+    rlSetMatrixModelview(xr_view);
+}
+
+void BeginView(unsigned int index) {
+    assert(rlxr.frameActive && rlxr.viewActiveIndex == ~0);
+    assert(index < rlxr.viewCount);
+
+    if (rlxr.replay.file)
+    {
+        // no swapchains without a runtime, replayed views are rendered side by side into the current framebuffer
+
+        rlDrawRenderBatchActive();
+
+        int w = rlGetFramebufferWidth() / rlxr.viewCount;
+        int h = rlGetFramebufferHeight();
+
+        rlViewport(index * w, 0, w, h);
+        rlEnableDepthTest();
+
+        rlxrSetupViewCamera(index);
+
+        rlxr.viewActiveIndex = index;
+        return;
+    }
+
+    // acquire swapchain images
+
+    rlxrViewBuffers *view = &rlxr.viewBufs[index];
+
+    XrSwapchainImageAcquireInfo acqInfo = {XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO};
+    uint32_t colorAcquiredIndex, depthAcquiredIndex;
+
+    XrResult res = xrAcquireSwapchainImage(view->colorSwapchain, &acqInfo, &colorAcquiredIndex);
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to acquire an image from swapchain (%s)", rlxrFormatResult(res));
+    }
+
+    if (rlxr.depthSupported)
+    {
+        res = xrAcquireSwapchainImage(view->depthSwapchain, &acqInfo, &depthAcquiredIndex);
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_ERROR, "XR: Failed to acquire an image from swapchain (%s)", rlxrFormatResult(res));
+        }
+    }
+
+    XrSwapchainImageWaitInfo waitInfo = {XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO};
+    waitInfo.timeout = 1000;
+
+    // FIXME: better handle timeouts
+
+    do
+    {
+        res = xrWaitSwapchainImage(view->colorSwapchain, &waitInfo);
+    } while (res == XR_TIMEOUT_EXPIRED);
+
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to wait for an image from swapchain (%s)", rlxrFormatResult(res));
+    }
+
+    if (rlxr.depthSupported)
+    {
+        do
+        {
+            res = xrWaitSwapchainImage(view->depthSwapchain, &waitInfo);
+        } while (res == XR_TIMEOUT_EXPIRED);
+
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_ERROR, "XR: Failed to wait for an image from swapchain (%s)", rlxrFormatResult(res));
+        }
+    }
+
+    // setup viewport and rlgl (very similar setup to BeginMode3D)
+
+    rlDrawRenderBatchActive();
+
+    rlxr.projectionViews[index].pose = rlxr.views[index].pose;
+    rlxr.projectionViews[index].fov = rlxr.views[index].fov;
+
+    if (rlxr.depthSupported)
+    {
+        rlxr.depthInfoViews[index].nearZ = rlGetCullDistanceNear();
+        rlxr.depthInfoViews[index].farZ = rlGetCullDistanceFar();
+    }
+
+    int w = rlxr.viewProps[index].recommendedImageRectWidth;
+    int h = rlxr.viewProps[index].recommendedImageRectHeight;
+
+    rlViewport(0, 0, w, h);
+    rlScissor(0, 0, w, h);
+
+    rlFramebufferAttach(view->framebuffer, view->colorImages[colorAcquiredIndex].image, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+    if (rlxr.depthSupported)
+    {
+        // attach XrSwapchain depth if supported, if not a render buffer is already attached from swapchain setup
+        rlFramebufferAttach(view->framebuffer, view->depthImages[depthAcquiredIndex].image, RL_ATTACHMENT_DEPTH, RL_ATTACHMENT_TEXTURE2D, 0);
+    }
+
+    rlEnableFramebuffer(view->framebuffer);
+    rlSetFramebufferWidth(w);
+    rlSetFramebufferHeight(h);
+
+    rlEnableDepthTest();
+
+    // setup view camera
+
+    rlxrSetupViewCamera(index);
+
+    rlxr.viewActiveIndex = index;
+}
+
+void EndView() {
+    assert(rlxr.frameActive && rlxr.viewActiveIndex != ~0);
+
+    rlDrawRenderBatchActive();
+
+    if (rlxr.latency.file)
+    {
+        // timestamp GPU completion of the last rendered view, the GL clock is converted to the monotonic clock
+        // with an offset sampled now (the GL_TIMESTAMP get doesn't wait for the queued commands)
+        rlxrLatencyFrame *frame = &rlxr.latency.frames[rlxr.latency.frameIndex % RLXR_LATENCY_FRAMES];
+
+        GLint64 glTime = 0;
+        rlxr.latency.GetInteger64v(GL_TIMESTAMP, &glTime);
+        frame->clockOffset = rlxrGetMonotonicTime() - (int64_t)glTime;
+
+        rlxr.latency.QueryCounter(frame->query, GL_TIMESTAMP);
+        frame->queryIssued = true;
+    }
+
+    // release swapchains (none when replaying)
+
+    if (!rlxr.replay.file)
+    {
+        XrSwapchainImageReleaseInfo relInfo = {XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO};
+
+        XrResult res = xrReleaseSwapchainImage(rlxr.viewBufs[rlxr.viewActiveIndex].colorSwapchain, &relInfo);
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_ERROR, "XR: Failed to release a swapchain image (%s)", rlxrFormatResult(res));
+        }
+
+        if (rlxr.depthSupported)
+        {
+            res = xrReleaseSwapchainImage(rlxr.viewBufs[rlxr.viewActiveIndex].depthSwapchain, &relInfo);
+            if (XR_FAILED(res))
+            {
+                TRACELOG(LOG_ERROR, "XR: Failed to release a swapchain image (%s)", rlxrFormatResult(res));
+            }
+        }
+    }
+
+    // return rlgl to a default state
+
+    rlMatrixMode(RL_PROJECTION);
+    rlPopMatrix();
+
+    rlMatrixMode(RL_MODELVIEW);
+    rlLoadIdentity();
+
+    rlDisableFramebuffer();
+    rlDisableDepthTest();
+
+#ifndef RLXR_STANDALONE
+    // a hacky way to tell raylib to restore its default window viewport
+    EndTextureMode();
+#endif
+
+    rlxr.viewActiveIndex = ~0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Actions
+//----------------------------------------------------------------------------------
+
+static inline unsigned int rlxrActionSlot(unsigned int set, unsigned int hash) {
+    // (action names are only unique within a set)
+    return hash ^ (set * 0x9e3779b9u);
+}
+
+static void rlxrInsertActionName(unsigned int action) {
+    // inserts an action into the name hash table, growing the table to keep its load under 1/2
+
+    if (rlxr.actionCount * 2 > rlxr.actionTableCap)
+    {
+        RL_FREE(rlxr.actionTable);
+
+        rlxr.actionTableCap = rlxr.actionTableCap ? rlxr.actionTableCap * 2 : 16;
+        rlxr.actionTable = (unsigned int *)RL_CALLOC(rlxr.actionTableCap, sizeof(unsigned int));
+
+        // rehash all older actions
+
+        for (unsigned int i = 0; i < action; i++) rlxrInsertActionName(i);
+    }
+
+    rlxrAction *ac = &rlxr.actions[action];
+    if (ac->set == RLXR_INTERNAL_ACTION_SET) return; // (not visible to lookups)
+
+    unsigned int mask = rlxr.actionTableCap - 1;
+    unsigned int slot = rlxrActionSlot(ac->set, ac->nameHash) & mask;
+
+    while (rlxr.actionTable[slot] != 0)
+    {
+        rlxrAction *other = &rlxr.actions[rlxr.actionTable[slot] - 1];
+        if (other->set == ac->set && other->nameHash == ac->nameHash)
+        {
+            TRACELOG(LOG_WARNING, "XR: Action %s has the same name hash as action %s, hash lookups will return the older action", ac->name, other->name);
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    rlxr.actionTable[slot] = action + 1;
+}
+
+unsigned int rlLoadActionSet(const char *name, int priority) {
+    assert(!rlxr.actionSetAttached);
+
+    unsigned int set = rlxrCreateActionSet(name, name, priority);
+    if (set != RLXR_NULL_ACTION_SET) rlxrRebuildActiveSets();
+
+    return set;
+}
+
+void rlUseActionSet(unsigned int set) {
+    assert(!rlxr.actionSetAttached);
+    if (set == RLXR_NULL_ACTION_SET) return;
+
+    if (set >= rlxr.actionSetCount)
+    {
+        TRACELOG(LOG_ERROR, "XR: Invalid action set %d", set);
+        return;
+    }
+
+    rlxr.currentActionSet = set;
+}
+
+void rlSetActionSetActive(unsigned int set, bool active) {
+    if (set >= rlxr.actionSetCount) return;
+    if (rlxr.actionSets[set].active == active) return;
+
+    rlxr.actionSets[set].active = active;
+    rlxrRebuildActiveSets();
+}
+
+bool rlIsActionSetActive(unsigned int set) {
+    if (set >= rlxr.actionSetCount) return false;
+    return rlxr.actionSets[set].active;
+}
+
+unsigned int rlLoadAction(const char *name, rlActionType type, rlActionDevices devices) {
+    assert(!rlxr.actionSetAttached);
+
+    // create action
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstringop-truncation"
+
+    XrActionCreateInfo actionInfo = {XR_TYPE_ACTION_CREATE_INFO};
+    strncpy(actionInfo.actionName, name, XR_MAX_ACTION_NAME_SIZE);
+    strncpy(actionInfo.localizedActionName, name, XR_MAX_LOCALIZED_ACTION_NAME_SIZE);
+
+#pragma GCC diagnostic pop
+
+    switch (type)
+    {
+    case RLXR_TYPE_BOOLEAN:
+        actionInfo.actionType = XR_ACTION_TYPE_BOOLEAN_INPUT;
+        break;
+
+    case RLXR_TYPE_FLOAT:
+        actionInfo.actionType = XR_ACTION_TYPE_FLOAT_INPUT;
+        break;
+
+    case RLXR_TYPE_VECTOR2F:
+        actionInfo.actionType = XR_ACTION_TYPE_VECTOR2F_INPUT;
+        break;
+
+    case RLXR_TYPE_POSE:
+        actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
+        break;
+
+    case RLXR_TYPE_VIBRATION:
+        actionInfo.actionType = XR_ACTION_TYPE_VIBRATION_OUTPUT;
+        break;
+    }
+
+    if (devices == 0 || (devices & ~((1 << RLXR_DEVICE_COUNT) - 1)) != 0)
+    {
+        TRACELOG(LOG_ERROR, "XR: invalid action devices for action %s", name);
+        return RLXR_NULL_ACTION;
+    }
+
+    if ((devices & RLXR_TRACKER_DEVICES) && !rlxr.ext.viveTracker)
+    {
+        TRACELOG(LOG_ERROR, "XR: Action %s uses trackers but XR_HTCX_vive_tracker_interaction is not supported", name);
+        return RLXR_NULL_ACTION;
+    }
+
+    if ((devices & RLXR_DEVICE_EYES) && !rlxr.ext.eyeGaze)
+    {
+        TRACELOG(LOG_ERROR, "XR: Action %s uses eye gaze but XR_EXT_eye_gaze_interaction is not supported", name);
+        return RLXR_NULL_ACTION;
+    }
+
+    XrPath subactionPaths[RLXR_DEVICE_COUNT];
+    unsigned int deviceCount = 0;
+
+    for (int slot = 0; slot < RLXR_DEVICE_COUNT; slot++)
+    {
+        if (devices & (1 << slot)) subactionPaths[deviceCount++] = rlxr.userPaths[slot];
+    }
+
+    actionInfo.countSubactionPaths = deviceCount;
+    actionInfo.subactionPaths = subactionPaths;
+
+    // note: replays have no runtime, only the action bookkeeping is kept
+    XrAction xrAction = XR_NULL_HANDLE;
+    XrActionSet xrSet = rlxr.currentActionSet == RLXR_INTERNAL_ACTION_SET ? rlxr.internalActionSet : rlxr.actionSets[rlxr.currentActionSet].actionSet;
+    XrResult res = rlxr.replay.file ? XR_SUCCESS : xrCreateAction(xrSet, &actionInfo, &xrAction);
+    if (XR_FAILED(res))
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to create action %s (%s)", name, rlxrFormatResult(res));
+        return RLXR_NULL_ACTION;
+    }
+
+    // create action spaces (if required)
+
+    XrSpace *xrSpaces = NULL;
+
+    if (type == RLXR_TYPE_POSE && !rlxr.replay.file)
+    {
+        xrSpaces = (XrSpace *)RL_CALLOC(deviceCount, sizeof(XrSpace));
+
+        XrActionSpaceCreateInfo spaceInfo = {XR_TYPE_ACTION_SPACE_CREATE_INFO};
+        spaceInfo.action = xrAction;
+        spaceInfo.poseInActionSpace = (XrPosef){{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+
+        for (unsigned int i = 0; i < deviceCount; i++)
+        {
+            spaceInfo.subactionPath = subactionPaths[i];
+            res = xrCreateActionSpace(rlxr.session, &spaceInfo, &xrSpaces[i]);
+
+            if (XR_FAILED(res)) break;
+        }
+
+        if (XR_FAILED(res))
+        {
+            TRACELOG(LOG_ERROR, "XR: Failed to create action spaces for action %s (%s)", name, rlxrFormatResult(res));
+
+            for (unsigned int i = 0; i < deviceCount; i++)
+            {
+                if (xrSpaces[i] != XR_NULL_HANDLE) xrDestroySpace(xrSpaces[i]);
+            }
+
+            RL_FREE(xrSpaces);
+            xrDestroyAction(xrAction);
+
+            return RLXR_NULL_ACTION;
+        }
+    }
+
+    // allocate a new rlxrAction
+
+    unsigned int actionIdx = rlxr.actionCount;
+    rlxrResizeArray((void **)&rlxr.actions, &rlxr.actionCount, &rlxr.actionCap, rlxr.actionCount + 1, sizeof(rlxrAction));
+
+    rlxrAction *action = &rlxr.actions[actionIdx];
+    action->action = xrAction;
+    action->actionSpaces = xrSpaces;
+    action->type = type;
+    action->subpaths = devices;
+    action->deviceCount = deviceCount;
+    action->sampleOffset = rlxr.sampleCount;
+
+    rlxr.sampleCount += deviceCount;
+    action->set = rlxr.currentActionSet;
+
+    // register name for lookups
+
+    snprintf(action->name, XR_MAX_ACTION_NAME_SIZE, "%s", name);
+    action->nameHash = rlGetActionHash(action->name);
+
+    rlxrInsertActionName(actionIdx);
+
+    return actionIdx;
+}
+
+static void appendBinding(rlxrAction *action, XrPath xrPath) {
+    assert(!rlxr.actionSetAttached);
+
+    if (xrPath == XR_NULL_PATH)
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to suggest binding, path error");
+        return;
+    }
+
+    // insert new binding
+
+    unsigned int bindingIdx = rlxr.bindingCount;
+    rlxrResizeArray((void **)&rlxr.bindings, &rlxr.bindingCount, &rlxr.bindingCap, rlxr.bindingCount + 1, sizeof(rlxrBinding));
+
+    rlxrBinding *binding = &rlxr.bindings[bindingIdx];
+    binding->profile = rlxr.currentSuggestProfile;
+    binding->binding.action = action->action;
+    binding->binding.binding = xrPath;
+}
+
+// LUTs of all enum component paths (based on the khr/simple_controller profile)
+static const char *khrHandPaths[] = {
+    "/input/select/click",
+    "/input/menu/click",
+    "/input/grip/pose",
+    "/input/aim/pose",
+    "/output/haptic",
+};
+
+void rlSuggestBinding(unsigned int action, rlActionComponent component) {
+    if (action == RLXR_NULL_ACTION) return;
+
+    rlxrAction *ac = &rlxr.actions[action];
+
+    // khr components only exist on hands, a single invalid path would fail all bindings of the profile
+    rlActionDevices hands = (rlActionDevices)(ac->subpaths & RLXR_HAND_BOTH);
+    if (hands == 0)
+    {
+        TRACELOG(LOG_WARNING, "XR: Action %s has no hand devices, binding skipped (use rlSuggestBindingPro)", ac->name);
+        return;
+    }
+
+    rlSuggestBindingPro(action, hands, khrHandPaths[component]);
+}
+
+void rlSuggestProfile(const char *profilePath) {
+    assert(!rlxr.actionSetAttached);
+    if (rlxr.replay.file) return; // (bindings were resolved by the recorded runtime)
+
+    // load next interaction profile (bindings are submitted on attach)
+
+    rlxr.currentSuggestProfile = rlxrInternPath(profilePath);
+}
+
+void rlSuggestBindingPro(unsigned int action, rlActionDevices devices, const char *component) {
+    assert(!rlxr.actionSetAttached);
+    if (action == RLXR_NULL_ACTION || rlxr.replay.file) return;
+
+    rlxrAction *ac = &rlxr.actions[action];
+
+    for (int slot = 0; slot < RLXR_DEVICE_COUNT; slot++)
+    {
+        if (!(devices & (1 << slot))) continue;
+
+        appendBinding(ac, rlxrInternSubPath(rlxr.userPaths[slot], component));
+    }
+}
+
+static const char *rlxrNextToken(const char *text, char *token, int tokenSize) {
+    // reads the next whitespace separated token of a manifest line, returns the position after it (token is empty at line end)
+
+    while (*text == ' ' || *text == '\t' || *text == '\r') text++;
+
+    int len = 0;
+    while (*text && *text != ' ' && *text != '\t' && *text != '\r' && *text != '\n' && *text != '#')
+    {
+        if (len < tokenSize - 1) token[len++] = *text;
+        text++;
+    }
+
+    token[len] = '\0';
+    return text;
+}
+
+// manifest names of all rlActionDevices bits, [device slot]
+static const char *rlxrDeviceNames[RLXR_DEVICE_COUNT] = {
+    "left",
+    "right",
+    "head",
+    "gamepad",
+    "treadmill",
+    "tracker_handheld_object",
+    "tracker_left_foot",
+    "tracker_right_foot",
+    "tracker_left_shoulder",
+    "tracker_right_shoulder",
+    "tracker_left_elbow",
+    "tracker_right_elbow",
+    "tracker_left_knee",
+    "tracker_right_knee",
+    "tracker_waist",
+    "tracker_chest",
+    "tracker_camera",
+    "tracker_keyboard",
+    "eyes",
+};
+
+static bool rlxrParseManifestDevices(const char *token, rlActionDevices *devices) {
+    // parses a '+' separated list of device names (eg. left+right+tracker_waist)
+
+    unsigned int mask = 0;
+
+    while (*token)
+    {
+        size_t len = strcspn(token, "+");
+        bool found = false;
+
+        if (len == 4 && strncmp(token, "both", 4) == 0)
+        {
+            mask |= RLXR_HAND_BOTH;
+            found = true;
+        }
+
+        for (int slot = 0; slot < RLXR_DEVICE_COUNT && !found; slot++)
+        {
+            if (strlen(rlxrDeviceNames[slot]) == len && strncmp(token, rlxrDeviceNames[slot], len) == 0)
+            {
+                mask |= 1 << slot;
+                found = true;
+            }
+        }
+
+        if (!found) return false;
+
+        token += len;
+        if (*token == '+') token++;
+    }
+
+    *devices = (rlActionDevices)mask;
+    return mask != 0;
+}
+
+static bool rlxrParseManifestType(const char *token, rlActionType *type) {
+    if (strcmp(token, "bool") == 0) *type = RLXR_TYPE_BOOLEAN;
+    else if (strcmp(token, "float") == 0) *type = RLXR_TYPE_FLOAT;
+    else if (strcmp(token, "vector2") == 0) *type = RLXR_TYPE_VECTOR2F;
+    else if (strcmp(token, "pose") == 0) *type = RLXR_TYPE_POSE;
+    else if (strcmp(token, "vibration") == 0) *type = RLXR_TYPE_VIBRATION;
+    else return false;
+
+    return true;
+}
+
+static bool rlxrParseActionManifest(const char *text) {
+    char cmd[16], arg0[RLXR_MAX_PATH_LENGTH], arg1[RLXR_MAX_PATH_LENGTH], arg2[RLXR_MAX_PATH_LENGTH];
+    int lineNum = 1;
+
+    for (const char *line = text; *line; lineNum++)
+    {
+        const char *c = rlxrNextToken(line, cmd, sizeof(cmd));
+        c = rlxrNextToken(c, arg0, sizeof(arg0));
+        c = rlxrNextToken(c, arg1, sizeof(arg1));
+        c = rlxrNextToken(c, arg2, sizeof(arg2));
+
+        // advance to the next line (skipping comments)
+
+        while (*c && *c != '\n') c++;
+        line = *c ? c + 1 : c;
+
+        if (cmd[0] == '\0') continue; // empty or comment line
+
+        if (strcmp(cmd, "set") == 0)
+        {
+            // set <name> [priority]
+
+            unsigned int set = rlLoadActionSet(arg0, arg1[0] ? atoi(arg1) : 0);
+            if (set == RLXR_NULL_ACTION_SET) return false;
+
+            rlUseActionSet(set);
+        } else if (strcmp(cmd, "action") == 0)
+        {
+            // action <name> <bool|float|vector2|pose|vibration> <left|right|both>
+
+            rlActionType type;
+            rlActionDevices devices;
+
+            if (!rlxrParseManifestType(arg1, &type) || !rlxrParseManifestDevices(arg2, &devices))
+            {
+                TRACELOG(LOG_ERROR, "XR: Action manifest line %d: invalid action type or devices", lineNum);
+                return false;
+            }
+
+            if (rlLoadAction(arg0, type, devices) == RLXR_NULL_ACTION) return false;
+        } else if (strcmp(cmd, "profile") == 0)
+        {
+            // profile <interaction profile path>
+
+            rlSuggestProfile(arg0);
+
+            if (!rlxr.replay.file && (arg0[0] == '\0' || rlxr.currentSuggestProfile == XR_NULL_PATH))
+            {
+                // (bindings would be stored without a profile and never submitted)
+                TRACELOG(LOG_ERROR, "XR: Action manifest line %d: invalid interaction profile %s", lineNum, arg0);
+                return false;
+            }
+        } else if (strcmp(cmd, "bind") == 0)
+        {
+            // bind <action name> <left|right|both> <component path>
+            // note: names resolve in the last declared set first (see rlGetActionByName), the same name may be reused by multiple sets
+
+            unsigned int action = rlGetActionByName(arg0);
+            rlActionDevices devices;
+
+            if (action == RLXR_NULL_ACTION || !rlxrParseManifestDevices(arg1, &devices) || arg2[0] == '\0')
+            {
+                TRACELOG(LOG_ERROR, "XR: Action manifest line %d: invalid binding for action %s", lineNum, arg0);
+                return false;
+            }
+
+            rlSuggestBindingPro(action, devices, arg2);
+        } else
+        {
+            TRACELOG(LOG_ERROR, "XR: Action manifest line %d: unknown command %s", lineNum, cmd);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool rlLoadActionManifestFromMemory(const char *text) {
+    assert(!rlxr.actionSetAttached);
+
+    bool success = rlxrParseActionManifest(text);
+
+    // (also on errors, so that following rlLoadAction calls don't end up in a set of the manifest)
+    rlUseActionSet(RLXR_PRIMARY_ACTION_SET);
+
+    return success;
+}
+
+bool rlLoadActionManifest(const char *fileName) {
+    FILE *file = fopen(fileName, "rb");
+    if (!file)
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to open action manifest %s", fileName);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (size < 0)
+    {
+        TRACELOG(LOG_ERROR, "XR: Failed to read action manifest %s", fileName);
+        fclose(file);
+        return false;
+    }
+
+    char *text = (char *)RL_MALLOC(size + 1);
+    size_t read = fread(text, 1, size, file);
+    text[read] = '\0';
+
+    fclose(file);
+
+    bool success = rlLoadActionManifestFromMemory(text);
+    RL_FREE(text);
+
+    if (success) TRACELOG(LOG_INFO, "XR: Action manifest %s loaded successfully", fileName);
+    return success;
+}
+
+unsigned int rlGetActionHash(const char *name) {
+    return rlxrHashString(name);
+}
+
+const char *GetXrCurrentProfile(rlActionDevices device) {
+    int slot = rlxrDeviceSlot(device);
+    if (slot < 0 || rlxr.currentProfiles[slot] == XR_NULL_PATH) return NULL;
+
+    // note: interned on change, so this never calls the runtime
+    return rlxrPathString(rlxr.currentProfiles[slot]);
+}
+
+bool IsXrProfileChanged() {
+    return rlxr.profileChanged;
+}
+
+static unsigned int rlxrFindAction(unsigned int set, unsigned int hash, const char *name) {
+    // probes for an action of [set] with [hash], also matching [name] if not NULL (hash collisions)
+
+    if (rlxr.actionTableCap == 0) return RLXR_NULL_ACTION;
+
+    unsigned int mask = rlxr.actionTableCap - 1;
+    unsigned int slot = rlxrActionSlot(set, hash) & mask;
+
+    while (rlxr.actionTable[slot] != 0)
+    {
+        unsigned int action = rlxr.actionTable[slot] - 1;
+        rlxrAction *ac = &rlxr.actions[action];
+
+        if (ac->set == set && ac->nameHash == hash && (!name || strncmp(ac->name, name, XR_MAX_ACTION_NAME_SIZE) == 0)) return action;
+
+        slot = (slot + 1) & mask;
+    }
+
+    return RLXR_NULL_ACTION;
+}
+
+static unsigned int rlxrFindActionInAnySet(unsigned int hash, const char *name) {
+    // the current set first, then all other sets in load order
+
+    unsigned int action = rlxrFindAction(rlxr.currentActionSet, hash, name);
+
+    for (unsigned int set = 0; set < rlxr.actionSetCount && action == RLXR_NULL_ACTION; set++)
+    {
+        if (set != rlxr.currentActionSet) action = rlxrFindAction(set, hash, name);
+    }
+
+    return action;
+}
+
+unsigned int rlGetActionByHash(unsigned int hash) {
+    return rlxrFindActionInAnySet(hash, NULL);
+}
+
+unsigned int rlGetActionByName(const char *name) {
+    return rlxrFindActionInAnySet(rlGetActionHash(name), name);
+}
+
+unsigned int rlGetActionInSet(unsigned int set, const char *name) {
+    if (set >= rlxr.actionSetCount) return RLXR_NULL_ACTION;
+
+    return rlxrFindAction(set, rlGetActionHash(name), name);
+}
+
+rlBoolState rlGetBoolState(unsigned int action, rlActionDevices device) {
+    assert(rlxr.actionSetAttached);
+    if (action == RLXR_NULL_ACTION) return (rlBoolState){0, 0, 0};
+
+    rlxrActionSample scratch;
+    const rlxrActionSample *sample = rlxrGetActionSample(action, device, &scratch);
+    if (!sample) return (rlBoolState){0, 0, 0};
+
+    return (rlBoolState){sample->value.b, sample->active, sample->changed};
+}
+
+bool rlGetBool(unsigned int action, rlActionDevices device) {
+    rlBoolState state = rlGetBoolState(action, device);
+    return state.value && state.active;
+}
+
+rlFloatState rlGetFloatState(unsigned int action, rlActionDevices device) {
+    assert(rlxr.actionSetAttached);
+    if (action == RLXR_NULL_ACTION) return (rlFloatState){0.f, 0, 0};
+
+    rlxrActionSample scratch;
+    const rlxrActionSample *sample = rlxrGetActionSample(action, device, &scratch);
+    if (!sample) return (rlFloatState){0.f, 0, 0};
+
+    return (rlFloatState){sample->value.f, sample->active, sample->changed};
+}
+
+float rlGetFloat(unsigned int action, rlActionDevices device) {
+    rlFloatState state = rlGetFloatState(action, device);
+    return state.active ? state.value : 0.0f;
+}
+
+rlVector2State rlGetVector2State(unsigned int action, rlActionDevices device) {
+    assert(rlxr.actionSetAttached);
+    if (action == RLXR_NULL_ACTION) return (rlVector2State){{0.f, 0.f}, 0, 0};
+
+    rlxrActionSample scratch;
+    const rlxrActionSample *sample = rlxrGetActionSample(action, device, &scratch);
+    if (!sample) return (rlVector2State){{0.f, 0.f}, 0, 0};
+
+    return (rlVector2State){sample->value.v, sample->active, sample->changed};
+}
+
+Vector2 rlGetVector2(unsigned int action, rlActionDevices device) {
+    rlVector2State state = rlGetVector2State(action, device);
+    return state.active ? state.value : (Vector2){0.f, 0.f};
+}
+
+static rlPoseState rlxrSampleToPoseState(const rlxrActionSample *sample) {
+    if (!sample || !sample->active)
+    {
+        // return null pose if device not active
+        return (rlPoseState){(rlPose){{}, {}, 0, 0}, false};
+    }
+
+    return (rlPoseState){xrPoseToRlPose(sample->pose, sample->locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT, sample->locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT), true};
+}
+
+rlPoseState rlGetPoseState(unsigned int action, rlActionDevices device) {
+    assert(rlxr.actionSetAttached);
+    if (action == RLXR_NULL_ACTION) return (rlPoseState){(rlPose){{}, {}, 0, 0}, 0};
+
+    rlxrActionSample scratch;
+    return rlxrSampleToPoseState(rlxrGetActionSample(action, device, &scratch));
+}
+
+rlPoseState rlGetPoseStateAt(unsigned int action, rlActionDevices device, long long time) {
+    assert(rlxr.actionSetAttached);
+    if (action == RLXR_NULL_ACTION) return (rlPoseState){(rlPose){{}, {}, 0, 0}, 0};
+
+    // note: replays only hold the snapshot poses
+    if (time == rlxr.frameState.predictedDisplayTime || rlxr.replay.file) return rlGetPoseState(action, device);
+
+    int slot = rlxrDeviceSlot(device);
+    if (slot < 0)
+    {
+        TRACELOG(LOG_WARNING, "XR: Unsupported device in getPose (action: %d)", action);
+        return (rlPoseState){(rlPose){{}, {}, 0, 0}, 0};
+    }
 
-    rlxr.viewActiveIndex = ~0;
+    if (rlxrActionDeviceIndex(&rlxr.actions[action], slot) < 0) return (rlPoseState){(rlPose){{}, {}, 0, 0}, 0};
+
+    rlxrActionSample sample;
+    rlxrSampleAction(action, slot, time, &sample);
+
+    return rlxrSampleToPoseState(&sample);
 }
 
-//----------------------------------------------------------------------------------
-// Module Functions Definition - Actions
-//----------------------------------------------------------------------------------
+rlPose rlGetPose(unsigned int action, rlActionDevices device) {
+    rlPoseState state = rlGetPoseState(action, device);
+    return state.active ? state.value : (rlPose){{}, {}, 0, 0};
+}
 
-static void rlxrResizeArray(void **ptr, unsigned int *size, unsigned int *cap, unsigned int new_size, unsigned int elem_size) {
-    *size = new_size;
-    if (new_size <= *cap) return;
+rlVelocity rlGetVelocity(unsigned int action, rlActionDevices device) {
+    assert(rlxr.actionSetAttached);
+    if (action == RLXR_NULL_ACTION) return (rlVelocity){0};
 
-    unsigned int new_cap = *cap * 2;
-    *cap = new_cap > new_size ? new_cap : new_size;
+    rlxrActionSample scratch;
+    const rlxrActionSample *sample = rlxrGetActionSample(action, device, &scratch);
+    if (!sample || !sample->active) return (rlVelocity){0};
 
-    *ptr = RL_REALLOC(*ptr, *cap * elem_size);
+    return xrVelocityToRlVelocity(sample->velocityFlags, sample->linearVelocity, sample->angularVelocity);
 }
 
-unsigned int rlLoadAction(const char *name, rlActionType type, rlActionDevices devices) {
-    assert(!rlxr.actionSetAttached);
+rlPose rlGetPoseAt(unsigned int action, rlActionDevices device, long long time) {
+    rlPoseState state = rlGetPoseStateAt(action, device, time);
+    return state.active ? state.value : (rlPose){{}, {}, 0, 0};
+}
 
-    // create action
+void rlLocatePoses(const unsigned int *actions, const rlActionDevices *devices, int count, rlPose *poses) {
+    assert(rlxr.actionSetAttached);
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wstringop-truncation"
+#ifndef RLXR_DIRECT_ACTION_QUERIES
+    // all pose actions are already batch located by UpdateXr, read from the snapshot
 
-    XrActionCreateInfo actionInfo = {XR_TYPE_ACTION_CREATE_INFO};
-    strncpy(actionInfo.actionName, name, XR_MAX_ACTION_NAME_SIZE);
-    strncpy(actionInfo.localizedActionName, name, XR_MAX_LOCALIZED_ACTION_NAME_SIZE);
+    for (int i = 0; i < count; i++) poses[i] = rlGetPose(actions[i], devices[i]);
+#else
+    rlxrActionSample *samples = (rlxrActionSample *)RL_CALLOC(count, sizeof(rlxrActionSample));
+    rlxr.locateCount = 0;
 
-#pragma GCC diagnostic pop
+    // fetch action states, collecting active pose spaces
 
-    switch (type)
+    for (int i = 0; i < count; i++)
     {
-    case RLXR_TYPE_BOOLEAN:
-        actionInfo.actionType = XR_ACTION_TYPE_BOOLEAN_INPUT;
-        break;
+        if (actions[i] == RLXR_NULL_ACTION) continue;
 
-    case RLXR_TYPE_FLOAT:
-        actionInfo.actionType = XR_ACTION_TYPE_FLOAT_INPUT;
-        break;
+        int index = rlxrActionDeviceIndex(&rlxr.actions[actions[i]], rlxrDeviceSlot(devices[i]));
+        if (index < 0) continue;
 
-    case RLXR_TYPE_VECTOR2F:
-        actionInfo.actionType = XR_ACTION_TYPE_VECTOR2F_INPUT;
-        break;
+        rlxrSampleActionState(actions[i], rlxrDeviceSlot(devices[i]), &samples[i]);
 
-    case RLXR_TYPE_POSE:
-        actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
-        break;
+        if (samples[i].active)
+        {
+            rlxrReserveLocate(rlxr.locateCount + 1);
 
-    case RLXR_TYPE_VIBRATION:
-        actionInfo.actionType = XR_ACTION_TYPE_VIBRATION_OUTPUT;
-        break;
+            rlxr.locateSpaces[rlxr.locateCount] = rlxr.actions[actions[i]].actionSpaces[index];
+            rlxr.locateTargets[rlxr.locateCount] = &samples[i];
+            rlxr.locateCount++;
+        }
     }
 
-    switch (devices)
-    {
-    case RLXR_HAND_LEFT:
-        actionInfo.countSubactionPaths = 1;
-        actionInfo.subactionPaths = &rlxr.userPaths[0];
-        break;
-
-    case RLXR_HAND_RIGHT:
-        actionInfo.countSubactionPaths = 1;
-        actionInfo.subactionPaths = &rlxr.userPaths[1];
-        break;
-
-    case RLXR_HAND_BOTH:
-        actionInfo.countSubactionPaths = 2;
-        actionInfo.subactionPaths = rlxr.userPaths;
-        break;
+    // locate all at once
 
-    default:
-        TRACELOG(LOG_ERROR, "XR: invalid action devices for action %s", name);
-        return RLXR_NULL_ACTION;
-    }
+    if (rlxr.locateCount != 0) rlxrLocateSpaces(rlxr.locateSpaces, rlxr.locateCount, rlxr.frameState.predictedDisplayTime, rlxr.locateResults, NULL);
 
-    XrAction xrAction;
-    XrResult res = xrCreateAction(rlxr.actionSet, &actionInfo, &xrAction);
-    if (XR_FAILED(res))
+    for (unsigned int i = 0; i < rlxr.locateCount; i++)
     {
-        TRACELOG(LOG_ERROR, "XR: Failed to create action %s (%s)", name, rlxrFormatResult(res));
-        return RLXR_NULL_ACTION;
+        rlxr.locateTargets[i]->locationFlags = rlxr.locateResults[i].locationFlags;
+        rlxr.locateTargets[i]->pose = rlxr.locateResults[i].pose;
     }
 
-    // create action space (if required)
-
-    XrSpace xrSpaces[RLXR_MAX_SPACES_PER_ACTION] = {XR_NULL_HANDLE, XR_NULL_HANDLE};
-
-    if (type == RLXR_TYPE_POSE)
+    for (int i = 0; i < count; i++)
     {
-        XrActionSpaceCreateInfo spaceInfo = {XR_TYPE_ACTION_SPACE_CREATE_INFO};
-        spaceInfo.action = xrAction;
-        spaceInfo.poseInActionSpace = (XrPosef){{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
-
-        switch (devices)
-        {
-        case RLXR_HAND_LEFT:
-            spaceInfo.subactionPath = rlxr.userPaths[0];
-            res = xrCreateActionSpace(rlxr.session, &spaceInfo, &xrSpaces[0]);
-            break;
-
-        case RLXR_HAND_RIGHT:
-            spaceInfo.subactionPath = rlxr.userPaths[1];
-            res = xrCreateActionSpace(rlxr.session, &spaceInfo, &xrSpaces[1]);
-            break;
-
-        case RLXR_HAND_BOTH:
-            for (int i = 0; i < 2; i++)
-            {
-                spaceInfo.subactionPath = rlxr.userPaths[i];
-                res = xrCreateActionSpace(rlxr.session, &spaceInfo, &xrSpaces[i]);
+        rlPoseState state = rlxrSampleToPoseState(&samples[i]);
+        poses[i] = state.active ? state.value : (rlPose){{}, {}, 0, 0};
+    }
 
-                if (XR_FAILED(res)) break;
-            }
-            break;
-        }
+    RL_FREE(samples);
+#endif
+}
 
-        if (XR_FAILED(res))
-        {
-            TRACELOG(LOG_ERROR, "XR: Failed to create action spaces for action %s (%s)", name, rlxrFormatResult(res));
-            return RLXR_NULL_ACTION;
-        }
-    }
+bool rlPollXrInputEvent(rlInputEvent *event) {
+    if (rlxr.inputEventCount == 0) return false;
 
-    // allocate a new rlxrAction
+    *event = rlxr.inputEvents[rlxr.inputEventHead];
 
-    unsigned int actionIdx = rlxr.actionCount;
-    rlxrResizeArray((void **)&rlxr.actions, &rlxr.actionCount, &rlxr.actionCap, rlxr.actionCount + 1, sizeof(rlxrAction));
+    rlxr.inputEventHead = (rlxr.inputEventHead + 1) % RLXR_MAX_INPUT_EVENTS;
+    rlxr.inputEventCount--;
 
-    rlxrAction *action = &rlxr.actions[actionIdx];
-    action->action = xrAction;
-    memcpy(action->actionSpaces, xrSpaces, sizeof(action->actionSpaces));
-    action->subpaths = devices;
+    return true;
+}
 
-    return actionIdx;
+void rlClearXrInputEvents() {
+    rlxr.inputEventHead = 0;
+    rlxr.inputEventCount = 0;
 }
 
-static void appendBinding(rlxrAction *action, const char *path) {
-    assert(!rlxr.actionSetAttached);
+void rlSetActionFilter(unsigned int action, rlActionFilter filter, float param0, float param1) {
+    if (action == RLXR_NULL_ACTION || action >= rlxr.actionCount) return;
 
-    // convert path
+    rlxrAction *ac = &rlxr.actions[action];
 
-    XrPath xrPath;
-    XrResult res = xrStringToPath(rlxr.instance, path, &xrPath);
+    bool poseFilter = filter == RLXR_FILTER_ONE_EURO || filter == RLXR_FILTER_SPRING;
+    bool valueFilter = filter == RLXR_FILTER_DEADZONE;
 
-    if (XR_FAILED(res))
+    if ((poseFilter && ac->type != RLXR_TYPE_POSE) || (valueFilter && ac->type != RLXR_TYPE_FLOAT && ac->type != RLXR_TYPE_VECTOR2F))
     {
-        TRACELOG(LOG_ERROR, "XR: Failed to suggest binding, path error (%s)", rlxrFormatResult(res));
+        TRACELOG(LOG_WARNING, "XR: Filter %d not supported by the type of action %s", filter, ac->name);
         return;
     }
 
-    // insert new binding
+    if (valueFilter && (param0 < 0.f || param0 >= 1.f))
+    {
+        TRACELOG(LOG_WARNING, "XR: Deadzone of action %s out of range [0.0, 1.0)", ac->name);
+        return;
+    }
 
-    unsigned int bindingIdx = rlxr.bindingCount;
-    rlxrResizeArray((void **)&rlxr.bindings, &rlxr.bindingCount, &rlxr.bindingCap, rlxr.bindingCount + 1, sizeof(XrActionSuggestedBinding));
+    ac->filter = filter;
+    ac->filterParams[0] = param0;
+    ac->filterParams[1] = param1;
 
-    XrActionSuggestedBinding *binding = &rlxr.bindings[bindingIdx];
-    binding->action = action->action;
-    binding->binding = xrPath;
+    rlxr.filters.dirty = true;
 }
 
-// LUTs of all enum component paths (based on the khr/simple_controller profile)
-static const char *khrHandPaths[] = {
-    "/input/select/click",
-    "/input/menu/click",
-    "/input/grip/pose",
-    "/input/aim/pose",
-    "/output/haptic",
-};
+const rlInputSnapshot *rlAcquireInputSnapshot() {
+    for (;;)
+    {
+        long latest = RLXR_ATOMIC_LOAD(&rlxr.latestSnapshot);
+        if (latest == 0) return NULL;
 
-void rlSuggestBinding(unsigned int action, rlActionComponent component) {
-    rlxrAction *ac = &rlxr.actions[action];
+        rlInputSnapshot *snapshot = &rlxr.snapshots[latest - 1];
+        RLXR_ATOMIC_ADD(&snapshot->refs, 1);
 
-    rlSuggestBindingPro(action, ac->subpaths, khrHandPaths[component]);
+        // still the latest after taking the reference, so UpdateXr won't rewrite it (retried only when a frame was published in between)
+        if (RLXR_ATOMIC_LOAD(&rlxr.latestSnapshot) == latest) return snapshot;
+
+        RLXR_ATOMIC_ADD(&snapshot->refs, -1);
+    }
 }
 
-void rlSuggestProfile(const char *profilePath) {
-    // submit buffered bindings
-    submitSuggestedBindings();
+void rlReleaseInputSnapshot(const rlInputSnapshot *snapshot) {
+    if (!snapshot) return;
+    RLXR_ATOMIC_ADD(&((rlInputSnapshot *)snapshot)->refs, -1);
+}
 
-    // load next interaction profile
-    xrStringToPath(rlxr.instance, profilePath, &rlxr.currentSuggestProfile);
+long long rlGetSnapshotTime(const rlInputSnapshot *snapshot) {
+    return snapshot ? snapshot->time : 0;
 }
 
-void rlSuggestBindingPro(unsigned int action, rlActionDevices devices, const char *component) {
-    assert(!rlxr.actionSetAttached);
-    if (action == RLXR_NULL_ACTION) return;
+static const rlxrActionSample *rlxrGetSnapshotSample(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device) {
+    // note: only reads action layout, which doesn't change after attach
+    if (!snapshot || action == RLXR_NULL_ACTION) return NULL;
 
-    rlxrAction *ac = &rlxr.actions[action];
-    static char pathBuf[RLXR_MAX_PATH_LENGTH];
+    int slot = rlxrDeviceSlot(device);
+    if (slot < 0) return NULL;
 
-    if (devices == RLXR_HAND_BOTH)
-    {
-        strncpy(pathBuf, "/user/hand/left", RLXR_MAX_PATH_LENGTH);
-        strncat(pathBuf, component, RLXR_MAX_PATH_LENGTH - strlen(pathBuf));
-        appendBinding(ac, pathBuf);
+    int index = rlxrActionDeviceIndex(&rlxr.actions[action], slot);
+    if (index < 0) return NULL;
 
-        strncpy(pathBuf, "/user/hand/right", RLXR_MAX_PATH_LENGTH);
-        strncat(pathBuf, component, RLXR_MAX_PATH_LENGTH - strlen(pathBuf));
-        appendBinding(ac, pathBuf);
-    } else
-    {
-        const char *userPath = devices == RLXR_HAND_LEFT ? "/user/hand/left" : "/user/hand/right";
-        strncpy(pathBuf, userPath, RLXR_MAX_PATH_LENGTH);
-        strncat(pathBuf, component, RLXR_MAX_PATH_LENGTH - strlen(pathBuf));
+    return &snapshot->samples[rlxr.actions[action].sampleOffset + index];
+}
 
-        appendBinding(ac, pathBuf);
-    }
+rlBoolState rlGetSnapshotBoolState(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device) {
+    const rlxrActionSample *sample = rlxrGetSnapshotSample(snapshot, action, device);
+    if (!sample) return (rlBoolState){0, 0, 0};
+
+    return (rlBoolState){sample->value.b, sample->active, sample->changed};
 }
 
-rlBoolState rlGetBoolState(unsigned int action, rlActionDevices device) {
-    assert(rlxr.actionSetAttached);
-    if (action == RLXR_NULL_ACTION) return (rlBoolState){0, 0, 0};
+rlFloatState rlGetSnapshotFloatState(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device) {
+    const rlxrActionSample *sample = rlxrGetSnapshotSample(snapshot, action, device);
+    if (!sample) return (rlFloatState){0.f, 0, 0};
 
-    rlxrAction *ac = &rlxr.actions[action];
+    return (rlFloatState){sample->value.f, sample->active, sample->changed};
+}
 
-    XrActionStateGetInfo getInfo = {XR_TYPE_ACTION_STATE_GET_INFO};
-    getInfo.action = ac->action;
+rlVector2State rlGetSnapshotVector2State(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device) {
+    const rlxrActionSample *sample = rlxrGetSnapshotSample(snapshot, action, device);
+    if (!sample) return (rlVector2State){{0.f, 0.f}, 0, 0};
 
-    switch (device)
-    {
-    case RLXR_HAND_LEFT:
-        getInfo.subactionPath = rlxr.userPaths[0];
-        break;
+    return (rlVector2State){sample->value.v, sample->active, sample->changed};
+}
 
-    case RLXR_HAND_RIGHT:
-        getInfo.subactionPath = rlxr.userPaths[1];
-        break;
+rlPoseState rlGetSnapshotPoseState(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device) {
+    const rlxrActionSample *sample = rlxrGetSnapshotSample(snapshot, action, device);
+    if (!sample || !sample->active) return (rlPoseState){(rlPose){{}, {}, 0, 0}, false};
 
-    default:
-        TRACELOG(LOG_WARNING, "XR: Unsupported device in getBool (action: %d)", action);
-        return (rlBoolState){0, 0, 0};
-    }
+    rlPose pose = xrPoseToRlPoseOffset(sample->pose, sample->locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT, sample->locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT, snapshot->refPosition, snapshot->refOrientation);
+    return (rlPoseState){pose, true};
+}
 
-    XrActionStateBoolean state = {XR_TYPE_ACTION_STATE_BOOLEAN};
-    XrResult res = xrGetActionStateBoolean(rlxr.session, &getInfo, &state);
-    if (XR_FAILED(res))
-    {
-        TRACELOG(LOG_ERROR, "XR: Failed to get bool action (action: %d; result: %s)", action, rlxrFormatResult(res));
-        return (rlBoolState){0, 0, 0};
-    }
+rlVelocity rlGetSnapshotVelocity(const rlInputSnapshot *snapshot, unsigned int action, rlActionDevices device) {
+    const rlxrActionSample *sample = rlxrGetSnapshotSample(snapshot, action, device);
+    if (!sample || !sample->active) return (rlVelocity){0};
 
-    return (rlBoolState){(bool)state.currentState, (bool)state.isActive, (bool)state.changedSinceLastSync};
+    return xrVelocityToRlVelocityOffset(sample->velocityFlags, sample->linearVelocity, sample->angularVelocity, snapshot->refOrientation);
 }
 
-bool rlGetBool(unsigned int action, rlActionDevices device) {
-    rlBoolState state = rlGetBoolState(action, device);
-    return state.value && state.active;
+rlPose rlGetSnapshotViewPose(const rlInputSnapshot *snapshot) {
+    if (!snapshot) return (rlPose){{}, {}, 0, 0};
+
+    XrSpaceLocationFlags flags = snapshot->viewLocation.locationFlags;
+    return xrPoseToRlPoseOffset(snapshot->viewLocation.pose, flags & XR_SPACE_LOCATION_POSITION_VALID_BIT, flags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT, snapshot->refPosition, snapshot->refOrientation);
 }
 
-rlFloatState rlGetFloatState(unsigned int action, rlActionDevices device) {
+void rlApplyHaptic(unsigned int action, rlActionDevices device, long duration, float amplitude) {
     assert(rlxr.actionSetAttached);
-    if (action == RLXR_NULL_ACTION) return (rlFloatState){0.f, 0, 0};
+    if (action == RLXR_NULL_ACTION || rlxr.replay.file) return;
 
     rlxrAction *ac = &rlxr.actions[action];
 
-    XrActionStateGetInfo getInfo = {XR_TYPE_ACTION_STATE_GET_INFO};
-    getInfo.action = ac->action;
+    XrHapticActionInfo hapticInfo = {XR_TYPE_HAPTIC_ACTION_INFO};
+    hapticInfo.action = ac->action;
 
-    switch (device)
+    int slot = rlxrDeviceSlot(device);
+    if (slot < 0)
     {
-    case RLXR_HAND_LEFT:
-        getInfo.subactionPath = rlxr.userPaths[0];
-        break;
+        TRACELOG(LOG_WARNING, "XR: Unsupported device in applyHaptic (action: %d)", action);
+        return;
+    }
 
-    case RLXR_HAND_RIGHT:
-        getInfo.subactionPath = rlxr.userPaths[1];
-        break;
+    hapticInfo.subactionPath = rlxr.userPaths[slot];
 
-    default:
-        TRACELOG(LOG_WARNING, "XR: Unsupported device in getFloat (action: %d)", action);
-        return (rlFloatState){0.f, 0, 0};
-    }
+    XrHapticVibration vibration = {XR_TYPE_HAPTIC_VIBRATION};
+    vibration.amplitude = amplitude;
+    vibration.duration = duration;
+    vibration.frequency = XR_FREQUENCY_UNSPECIFIED;
 
-    XrActionStateFloat state = {XR_TYPE_ACTION_STATE_FLOAT};
-    XrResult res = xrGetActionStateFloat(rlxr.session, &getInfo, &state);
+    XrResult res = xrApplyHapticFeedback(rlxr.session, &hapticInfo, (XrHapticBaseHeader *)&vibration);
     if (XR_FAILED(res))
     {
-        TRACELOG(LOG_ERROR, "XR: Failed to get float action (action: %d; result: %s)", action, rlxrFormatResult(res));
-        return (rlFloatState){0.f, 0, 0};
+        TRACELOG(LOG_ERROR, "XR: Failed to apply haptic action (action: %d; result: %s)", action, rlxrFormatResult(res));
     }
-
-    return (rlFloatState){state.currentState, (bool)state.isActive, (bool)state.changedSinceLastSync};
 }
 
-float rlGetFloat(unsigned int action, rlActionDevices device) {
-    rlFloatState state = rlGetFloatState(action, device);
-    return state.active ? state.value : 0.0f;
-}
+static rlxrHapticTarget *rlxrGetHapticTarget(unsigned int action, rlActionDevices device) {
+    // finds or creates the haptics engine target of an output action on a device, NULL if invalid
 
-rlVector2State rlGetVector2State(unsigned int action, rlActionDevices device) {
     assert(rlxr.actionSetAttached);
-    if (action == RLXR_NULL_ACTION) return (rlVector2State){{0.f, 0.f}, 0, 0};
+    if (action == RLXR_NULL_ACTION) return NULL;
 
-    rlxrAction *ac = &rlxr.actions[action];
-
-    XrActionStateGetInfo getInfo = {XR_TYPE_ACTION_STATE_GET_INFO};
-    getInfo.action = ac->action;
-
-    switch (device)
+    int slot = rlxrDeviceSlot(device);
+    if (rlxr.actions[action].type != RLXR_TYPE_VIBRATION || rlxrActionDeviceIndex(&rlxr.actions[action], slot) < 0)
     {
-    case RLXR_HAND_LEFT:
-        getInfo.subactionPath = rlxr.userPaths[0];
-        break;
-
-    case RLXR_HAND_RIGHT:
-        getInfo.subactionPath = rlxr.userPaths[1];
-        break;
-
-    default:
-        TRACELOG(LOG_WARNING, "XR: Unsupported device in getVector2 (action: %d)", action);
-        return (rlVector2State){{0.f, 0.f}, 0, 0};
+        TRACELOG(LOG_WARNING, "XR: Unsupported action or device in haptics (action: %d)", action);
+        return NULL;
     }
 
-    XrActionStateVector2f state = {XR_TYPE_ACTION_STATE_VECTOR2F};
-    XrResult res = xrGetActionStateVector2f(rlxr.session, &getInfo, &state);
-    if (XR_FAILED(res))
+    for (unsigned int i = 0; i < rlxr.hapticTargetCount; i++)
     {
-        TRACELOG(LOG_ERROR, "XR: Failed to get vector2 action (action: %d; result: %s)", action, rlxrFormatResult(res));
-        return (rlVector2State){{0.f, 0.f}, 0, 0};
+        if (rlxr.hapticTargets[i].action == action && rlxr.hapticTargets[i].slot == slot) return &rlxr.hapticTargets[i];
     }
 
-    return (rlVector2State){{state.currentState.x, state.currentState.y}, (bool)state.isActive, (bool)state.changedSinceLastSync};
-}
+    unsigned int targetIdx = rlxr.hapticTargetCount;
+    rlxrResizeArray((void **)&rlxr.hapticTargets, &rlxr.hapticTargetCount, &rlxr.hapticTargetCap, rlxr.hapticTargetCount + 1, sizeof(rlxrHapticTarget));
 
-Vector2 rlGetVector2(unsigned int action, rlActionDevices device) {
-    rlVector2State state = rlGetVector2State(action, device);
-    return state.active ? state.value : (Vector2){0.f, 0.f};
-}
+    rlxrHapticTarget *target = &rlxr.hapticTargets[targetIdx];
+    target->action = action;
+    target->slot = slot;
+    target->sampleRate = 0.f;
+    target->queuedUntil = 0;
 
-rlPoseState rlGetPoseState(unsigned int action, rlActionDevices device) {
-    assert(rlxr.actionSetAttached);
-    if (action == RLXR_NULL_ACTION) return (rlPoseState){(rlPose){{}, {}, 0, 0}, 0};
+    if (rlxr.ext.hapticPcm)
+    {
+        // query the device sample rate, PCM is device-specific
 
-    rlxrAction *ac = &rlxr.actions[action];
+        XrHapticActionInfo hapticInfo = {XR_TYPE_HAPTIC_ACTION_INFO};
+        hapticInfo.action = rlxr.actions[action].action;
+        hapticInfo.subactionPath = rlxr.userPaths[slot];
 
-    XrActionStateGetInfo getInfo = {XR_TYPE_ACTION_STATE_GET_INFO};
-    getInfo.action = ac->action;
+        XrDevicePcmSampleRateGetInfoFB rate = {XR_TYPE_DEVICE_PCM_SAMPLE_RATE_GET_INFO_FB};
+        XrResult res = rlxr.pfn.GetDeviceSampleRateFB(rlxr.session, &hapticInfo, &rate);
 
-    switch (device)
-    {
-    case RLXR_HAND_LEFT:
-        getInfo.subactionPath = rlxr.userPaths[0];
-        break;
+        if (XR_SUCCEEDED(res)) target->sampleRate = rate.sampleRate;
+    }
 
-    case RLXR_HAND_RIGHT:
-        getInfo.subactionPath = rlxr.userPaths[1];
-        break;
+    return target;
+}
 
-    default:
-        TRACELOG(LOG_WARNING, "XR: Unsupported device in getPose (action: %d)", action);
-        return (rlPoseState){(rlPose){{}, {}, 0, 0}, 0};
-    }
+static void rlxrQueueHapticEffect(unsigned int action, rlActionDevices device, const float *samples, int count, double interval, long long startTime, bool pcm) {
+    if (count <= 0 || interval <= 0.0 || rlxr.replay.file) return;
 
-    XrActionStatePose state = {XR_TYPE_ACTION_STATE_POSE};
-    XrResult res = xrGetActionStatePose(rlxr.session, &getInfo, &state);
-    if (XR_FAILED(res))
-    {
-        TRACELOG(LOG_ERROR, "XR: Failed to get pose action (action: %d; result: %s)", action, rlxrFormatResult(res));
-        return (rlPoseState){(rlPose){{}, {}, 0, 0}, 0};
-    }
+    rlxrHapticTarget *target = rlxrGetHapticTarget(action, device);
+    if (!target) return;
 
-    if (!state.isActive)
-    {
-        // return null pose if device not active
-        return (rlPoseState){(rlPose){{}, {}, 0, 0}, false};
-    }
+    unsigned int effectIdx = rlxr.hapticEffectCount;
+    rlxrResizeArray((void **)&rlxr.hapticEffects, &rlxr.hapticEffectCount, &rlxr.hapticEffectCap, rlxr.hapticEffectCount + 1, sizeof(rlxrHapticEffect));
 
-    // locate pose space
+    rlxrHapticEffect *effect = &rlxr.hapticEffects[effectIdx];
+    effect->action = action;
+    effect->slot = target->slot;
+    effect->start = startTime != 0 ? startTime : rlxr.frameState.predictedDisplayTime;
+    effect->interval = interval;
+    effect->count = count;
+    effect->samples = (float *)RL_MALLOC(count * sizeof(float));
+    effect->pcm = pcm;
 
-    XrSpaceLocation location = {XR_TYPE_SPACE_LOCATION};
-    res = xrLocateSpace(device == RLXR_HAND_LEFT ? ac->actionSpaces[0] : ac->actionSpaces[1], rlxr.referenceSpace, rlxr.frameState.predictedDisplayTime, &location);
-    if (XR_FAILED(res))
-    {
-        TRACELOG(LOG_ERROR, "XR: Failed to locate pose space (action: %d; result: %s)", action, rlxrFormatResult(res));
-        return (rlPoseState){(rlPose){{}, {}, 0, 0}, true};
-    }
+    memcpy(effect->samples, samples, count * sizeof(float));
+}
 
-    return (rlPoseState){xrPoseToRlPose(location.pose, location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT, location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT), (bool)state.isActive};
+void rlPlayHapticEnvelope(unsigned int action, rlActionDevices device, const float *amplitudes, int count, long interval, long long startTime) {
+    rlxrQueueHapticEffect(action, device, amplitudes, count, (double)interval, startTime, false);
 }
 
-rlPose rlGetPose(unsigned int action, rlActionDevices device) {
-    rlPoseState state = rlGetPoseState(action, device);
-    return state.active ? state.value : (rlPose){{}, {}, 0, 0};
+void rlPlayHapticPcm(unsigned int action, rlActionDevices device, const float *samples, int count, float sampleRate, long long startTime) {
+    if (sampleRate <= 0.f) return;
+
+    rlxrQueueHapticEffect(action, device, samples, count, 1e9 / sampleRate, startTime, true);
 }
 
-void rlApplyHaptic(unsigned int action, rlActionDevices device, long duration, float amplitude) {
+void rlStopHaptics(unsigned int action, rlActionDevices device) {
     assert(rlxr.actionSetAttached);
-    if (action == RLXR_NULL_ACTION) return;
+    if (action == RLXR_NULL_ACTION || rlxr.replay.file) return;
 
-    rlxrAction *ac = &rlxr.actions[action];
+    if (rlxr.actions[action].type != RLXR_TYPE_VIBRATION)
+    {
+        TRACELOG(LOG_WARNING, "XR: Unsupported action in haptics (action: %d)", action);
+        return;
+    }
 
-    XrHapticActionInfo hapticInfo = {XR_TYPE_HAPTIC_ACTION_INFO};
-    hapticInfo.action = ac->action;
+    int slot = rlxrDeviceSlot(device);
+    if (slot < 0) return;
+
+    // drop queued effects and the target
 
-    switch (device)
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < rlxr.hapticEffectCount; i++)
     {
-    case RLXR_HAND_LEFT:
-        hapticInfo.subactionPath = rlxr.userPaths[0];
-        break;
+        rlxrHapticEffect *effect = &rlxr.hapticEffects[i];
 
-    case RLXR_HAND_RIGHT:
-        hapticInfo.subactionPath = rlxr.userPaths[1];
-        break;
+        if (effect->action == action && effect->slot == slot)
+        {
+            RL_FREE(effect->samples);
+            continue;
+        }
 
-    default:
-        TRACELOG(LOG_WARNING, "XR: Unsupported device in applyHaptic (action: %d)", action);
-        return;
+        rlxr.hapticEffects[kept++] = *effect;
     }
 
-    XrHapticVibration vibration = {XR_TYPE_HAPTIC_VIBRATION};
-    vibration.amplitude = amplitude;
-    vibration.duration = duration;
-    vibration.frequency = XR_FREQUENCY_UNSPECIFIED;
+    rlxr.hapticEffectCount = kept;
 
-    XrResult res = xrApplyHapticFeedback(rlxr.session, &hapticInfo, (XrHapticBaseHeader *)&vibration);
+    kept = 0;
+    for (unsigned int i = 0; i < rlxr.hapticTargetCount; i++)
+    {
+        if (rlxr.hapticTargets[i].action == action && rlxr.hapticTargets[i].slot == slot) continue;
+        rlxr.hapticTargets[kept++] = rlxr.hapticTargets[i];
+    }
+
+    rlxr.hapticTargetCount = kept;
+
+    // stop the runtime side
+
+    XrHapticActionInfo hapticInfo = {XR_TYPE_HAPTIC_ACTION_INFO};
+    hapticInfo.action = rlxr.actions[action].action;
+    hapticInfo.subactionPath = rlxr.userPaths[slot];
+
+    XrResult res = xrStopHapticFeedback(rlxr.session, &hapticInfo);
     if (XR_FAILED(res))
     {
-        TRACELOG(LOG_ERROR, "XR: Failed to apply haptic action (action: %d; result: %s)", action, rlxrFormatResult(res));
+        TRACELOG(LOG_ERROR, "XR: Failed to stop haptic feedback (action: %d; result: %s)", action, rlxrFormatResult(res));
     }
 }
 
+bool IsXrHapticPcmSupported() {
+    return rlxr.instance && rlxr.ext.hapticPcm;
+}
+
 #if defined(__cplusplus)
 }
 #endif